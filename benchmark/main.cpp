@@ -0,0 +1,259 @@
+#include <Particle.hpp>
+#include <ForceField.hpp>
+#include <ThreadPool.hpp>
+#include <Simd.hpp>
+#include <Timer.hpp>
+
+#include <array>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <cmath>
+#include <random>
+#include <cstdio>
+
+namespace {
+    static constexpr const size_t ITERATIONS = 100u;
+
+    /**
+     * @brief Array-of-structures particle as stored by ParticleEmitter before SoA pool
+     */
+    struct Particle {
+        glm::vec3 position {glm::vec3{0.0f}};
+        glm::vec3 velocity {glm::vec3{0.0f}};
+        glm::vec3 rotation {glm::vec3{0.0f}};
+
+        std::array<float, 2> size;
+
+        std::array<glm::vec4, 2> color;
+
+        float life   {0.0f};
+        float remain {0.0f};
+
+        bool alive {false};
+    };
+
+    void update(std::vector<Particle>& pool, float deltaTime) noexcept {
+        for(auto& p : pool) {
+            if(!p.alive)
+                continue;
+
+            if(p.remain <= 0.0f) {
+                p.alive = false;
+                continue;
+            }
+
+            p.remain -= deltaTime;
+
+            p.rotation += p.velocity * deltaTime;
+            p.position += p.velocity * deltaTime;
+        }
+    }
+
+    void update(glem::ParticlePool& pool, float deltaTime) noexcept {
+        pool.compact();
+
+        glem::integrate(pool, 0u, pool.count(), deltaTime);
+    }
+
+    template<typename T>
+    float measure(T& pool) noexcept {
+        glem::Timer timer;
+
+        for(size_t i = 0; i < ITERATIONS; ++i)
+            update(pool, 1.0f / 60.0f);
+
+        return timer.mark() * 1000.0f / static_cast<float>(ITERATIONS);
+    }
+
+    void particles(size_t count) noexcept {
+        std::mt19937 device {42u};
+        std::uniform_real_distribution<float> velocity {-5.0f, 5.0f};
+
+        std::vector<Particle> aos(count);
+
+        glem::ParticlePool soa {count};
+
+        for(size_t i = 0; i < count; ++i) {
+            const glm::vec3 v {velocity(device), velocity(device), velocity(device)};
+
+            aos[i].velocity = v;
+            aos[i].life     = 1000.0f;
+            aos[i].remain   = 1000.0f;
+            aos[i].alive    = true;
+
+            const auto j = *soa.emplace();
+
+            soa.velocityX[j] = v.x;
+            soa.velocityY[j] = v.y;
+            soa.velocityZ[j] = v.z;
+            soa.life[j]      = 1000.0f;
+            soa.remain[j]    = 1000.0f;
+        }
+
+        const auto aosTime = measure(aos);
+        const auto soaTime = measure(soa);
+
+        std::printf("%10zu | %10.4f | %10.4f | %6.2fx\n", count, aosTime, soaTime, aosTime / soaTime);
+    }
+
+    template<typename Function>
+    float measure(Function&& function) noexcept {
+        glem::Timer timer;
+
+        for(size_t i = 0; i < ITERATIONS; ++i)
+            function();
+
+        return timer.mark() * 1000.0f / static_cast<float>(ITERATIONS);
+    }
+
+    /**
+     * @brief Scalar value noise matching ForceField lattice hash, per particle reference
+     */
+    float hash(glm::vec3 p) noexcept {
+        p  = glm::fract(p * 0.1031f);
+        p += glm::dot(p, glm::vec3{p.z, p.y, p.x} + 31.32f);
+
+        return glm::fract((p.x + p.y) * p.z) * 2.0f - 1.0f;
+    }
+
+    glm::vec3 noiseGradient(const glm::vec3& p) noexcept {
+        const auto i  = glm::floor(p);
+        const auto f  = p - i;
+        const auto u  = f * f * (3.0f - 2.0f * f);
+        const auto du = 6.0f * f * (1.0f - f);
+
+        const auto c000 = hash(i);
+        const auto c100 = hash(i + glm::vec3{1.0f, 0.0f, 0.0f});
+        const auto c010 = hash(i + glm::vec3{0.0f, 1.0f, 0.0f});
+        const auto c110 = hash(i + glm::vec3{1.0f, 1.0f, 0.0f});
+        const auto c001 = hash(i + glm::vec3{0.0f, 0.0f, 1.0f});
+        const auto c101 = hash(i + glm::vec3{1.0f, 0.0f, 1.0f});
+        const auto c011 = hash(i + glm::vec3{0.0f, 1.0f, 1.0f});
+        const auto c111 = hash(i + glm::vec3{1.0f, 1.0f, 1.0f});
+
+        const auto x00 = glm::mix(c000, c100, u.x);
+        const auto x10 = glm::mix(c010, c110, u.x);
+        const auto x01 = glm::mix(c001, c101, u.x);
+        const auto x11 = glm::mix(c011, c111, u.x);
+
+        return {
+            glm::mix(glm::mix(c100 - c000, c110 - c010, u.y), glm::mix(c101 - c001, c111 - c011, u.y), u.z) * du.x,
+            glm::mix(x10 - x00, x11 - x01, u.z) * du.y,
+            (glm::mix(x01, x11, u.y) - glm::mix(x00, x10, u.y)) * du.z
+        };
+    }
+
+    void curlNoise(std::vector<Particle>& pool, float deltaTime, float time, const glem::CurlNoiseField& field) noexcept {
+        for(auto& p : pool) {
+            glm::vec3 curl {0.0f};
+
+            auto frequency = field.frequency;
+            auto amplitude = 1.0f;
+
+            for(uint32_t octave = 0; octave < field.octaves; ++octave) {
+                const auto s = p.position * frequency + time * field.speed;
+
+                const auto n1 = noiseGradient(s);
+                const auto n2 = noiseGradient(s + glm::vec3{ 31.4f, 47.2f, 12.9f});
+                const auto n3 = noiseGradient(s + glm::vec3{-19.1f, 33.4f, 71.3f});
+
+                curl += glm::vec3{n3.y - n2.z, n1.z - n3.x, n2.x - n1.y} * (amplitude * frequency);
+
+                frequency *= 2.0f;
+                amplitude *= 0.5f;
+            }
+
+            p.velocity += curl * (field.strength * deltaTime);
+        }
+    }
+
+    void turbulence(size_t count) noexcept {
+        std::mt19937 device {42u};
+        std::uniform_real_distribution<float> position {-50.0f, 50.0f};
+
+        std::vector<Particle> aos(count);
+
+        glem::ParticlePool soa {count};
+
+        soa.emplace(count);
+
+        for(size_t i = 0; i < count; ++i) {
+            const glm::vec3 p {position(device), position(device), position(device)};
+
+            aos[i].position = p;
+
+            soa.positionX[i] = p.x;
+            soa.positionY[i] = p.y;
+            soa.positionZ[i] = p.z;
+        }
+
+        const glem::CurlNoiseField field;
+
+        const auto scalarTime = measure([&]() { curlNoise(aos, 1.0f / 60.0f, 0.0f, field); });
+        const auto simdTime   = measure([&]() { glem::applyForceField(soa, 0u, count, 1.0f / 60.0f, 0.0f, field); });
+
+        std::printf("%10zu | %10.4f | %10.4f | %6.2fx\n", count, scalarTime, simdTime, scalarTime / simdTime);
+    }
+
+    glem::EmitterDescriptor descriptor(size_t capacity) noexcept {
+        glem::EmitterDescriptor value;
+
+        value.capacity = capacity;
+        value.life     = 1000.0f;
+
+        return value;
+    }
+
+    void scaling(size_t threads) noexcept {
+        glem::ThreadPool pool {threads};
+
+        /**** one large emitter split into chunks ****/
+        glem::ParticleEmitter emitter {descriptor(1000000u), 42u};
+
+        emitter.spawn(1000000u);
+
+        const auto chunked = measure([&]() { emitter.update(1.0f / 60.0f, pool); });
+
+        /**** many independent emitters ****/
+        std::vector<std::unique_ptr<glem::ParticleEmitter>> emitters;
+        std::vector<glem::ParticleEmitter*> pointers;
+
+        for(size_t i = 0; i < 32u; ++i) {
+            emitters.emplace_back(std::make_unique<glem::ParticleEmitter>(descriptor(32768u), i));
+            emitters.back()->spawn(32768u);
+
+            pointers.emplace_back(emitters.back().get());
+        }
+
+        const auto concurrent = measure([&]() { glem::ParticleEmitter::update(pointers, 1.0f / 60.0f, pool); });
+
+        std::printf("%10zu | %12.4f | %12.4f\n", threads, chunked, concurrent);
+    }
+}
+
+int main() {
+    std::printf("Particle update, %s kernel, ms per update\n", glem::simd::name());
+    std::printf("%10s | %10s | %10s | %7s\n", "particles", "AoS", "SoA", "speedup");
+
+    for(auto count : {10000u, 100000u, 1000000u})
+        particles(count);
+
+    std::printf("\nCurl noise, ms per update\n");
+    std::printf("%10s | %10s | %10s | %7s\n", "particles", "scalar", glem::simd::name(), "speedup");
+
+    for(auto count : {10000u, 100000u})
+        turbulence(count);
+
+    std::printf("\nParallel update, ms per update\n");
+    std::printf("%10s | %12s | %12s\n", "threads", "1 x 1M", "32 x 32K");
+
+    const auto hardware = std::max(std::thread::hardware_concurrency(), 1u);
+
+    for(size_t threads = 1; threads < hardware; threads *= 2)
+        scaling(threads);
+
+    scaling(hardware);
+
+    return 0;
+}
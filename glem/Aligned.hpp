@@ -0,0 +1,54 @@
+#pragma once
+
+#include <new>
+#include <vector>
+#include <cstddef>
+
+namespace glem {
+
+    /**
+     * @brief Alignment of SIMD friendly storage (AVX register width)
+     */
+    static constexpr const size_t SIMD_ALIGNMENT = 32u;
+
+    template<typename T, size_t Alignment = SIMD_ALIGNMENT>
+    class AlignedAllocator {
+    public:
+        using value_type = T;
+
+        template<typename U> struct rebind {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+
+        template<typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {
+
+        }
+
+        inline T* allocate(size_t count) {
+            return static_cast<T*>(::operator new(count * sizeof (T), std::align_val_t{Alignment}));
+        }
+
+        inline void deallocate(T* ptr, size_t count) noexcept {
+            static_cast<void>(count);
+
+            ::operator delete(ptr, std::align_val_t{Alignment});
+        }
+
+        template<typename U>
+        inline bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept {
+            return true;
+        }
+
+        template<typename U>
+        inline bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept {
+            return false;
+        }
+    };
+
+    template<typename T>
+    using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+}
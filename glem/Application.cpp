@@ -4,14 +4,40 @@
 #include "Input.hpp"
 #include "Scene.hpp"
 #include "Mesh.hpp"
+#include "ProgramCache.hpp"
+#include "ProgramLibrary.hpp"
 
 #include "Log.hpp"
 #include "Timer.hpp"
 
 #include "Vertex.hpp"
 
+#include <iterator>
+
 namespace {
     static constexpr const char* TAG = "Application";
+
+    static constexpr const glem::Keyboard::Key SCENE_KEYS[] = {
+        glem::Keyboard::Key::D1,
+        glem::Keyboard::Key::D2,
+        glem::Keyboard::Key::D3,
+        glem::Keyboard::Key::D4
+    };
+
+    std::unique_ptr<glem::Scene> makeScene(size_t index) noexcept {
+        switch (index) {
+        case 0:
+            return std::make_unique<glem::ParticleScene>();
+        case 1:
+            return std::make_unique<glem::TextureMapScene>();
+        case 2:
+            return std::make_unique<glem::SkyboxScene>();
+        case 3:
+            return std::make_unique<glem::DynamicVertexSystemTest>();
+        }
+
+        return nullptr;
+    }
 }
 
 namespace glem {
@@ -36,7 +62,9 @@ namespace glem {
     {
         Timer timer;
 
-        std::unique_ptr<Scene> scene = std::make_unique<ParticleScene>();//= std::make_unique<DynamicVertexSystemTest>();
+        size_t current {0u};
+
+        std::unique_ptr<Scene> scene = makeScene(current);
 
         auto model = Shape::cube();
 
@@ -52,6 +80,21 @@ namespace glem {
             if(Keyboard::pressed(Keyboard::Key::Escape))
                 window_->close();
 
+            for(size_t i = 0; i < std::size(SCENE_KEYS); ++i) {
+                if(i == current || !Keyboard::pressed(SCENE_KEYS[i]))
+                    continue;
+
+                /**** old scene goes first, so its programs are unreferenced when library collects ****/
+                scene.reset();
+
+                ProgramLibrary::instance().collect();
+
+                current = i;
+                scene   = makeScene(current);
+
+                break;
+            }
+
             if(scene) {
                 scene->update(deltaTime);
                 scene->render();
@@ -84,6 +127,11 @@ namespace glem {
             return false;
         }
 
+        ProgramCache::instance().setDirectory("cache/programs");
+
+        /**** construct library before application finishes construction, so it outlives ~Application ****/
+        ProgramLibrary::instance();
+
         return true;
     }
 
@@ -94,7 +142,11 @@ namespace glem {
 
     Application::~Application()
     {
+        /**** programs must be deleted while context is still alive ****/
+        ProgramLibrary::instance().clear();
 
+        context_.reset();
+        window_.reset();
     }
 
 }
@@ -1,10 +1,143 @@
 #include "Buffer.hpp"
 
+#include "Log.hpp"
+#include "Hash.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+    static constexpr const char* TAG = "Buffer";
+
+    /**** vertex array currently bound to context, lets shared formats skip redundant binds ****/
+    static uint32_t boundVertexArray {0u};
+}
+
 namespace glem {
 
+    namespace {
+        /**
+         * @brief Allocate buffer storage, Stream buffers get immutable storage mapped for their lifetime
+         * @return Persistent mapping, nullptr for Static and Dynamic buffers
+         */
+        uint8_t* allocate(uint32_t handler, size_t size, const void* data, BufferUsage usage) noexcept {
+            switch (usage) {
+            case BufferUsage::Static:
+                glNamedBufferData(handler, static_cast<GLsizeiptr>(size), data, BufferUsageMap<BufferUsage::Static>::usage);
+                break;
+            case BufferUsage::Dynamic:
+                glNamedBufferData(handler, static_cast<GLsizeiptr>(size), data, BufferUsageMap<BufferUsage::Dynamic>::usage);
+                break;
+            case BufferUsage::Stream:
+                if(size == 0u) {
+                    Log::e(TAG, "Stream buffer requires non zero size.");
+                    return nullptr;
+                }
+
+                glNamedBufferStorage(handler, static_cast<GLsizeiptr>(size), data, BufferUsageMap<BufferUsage::Stream>::flags);
+
+                return static_cast<uint8_t*>(glMapNamedBufferRange(handler, 0, static_cast<GLsizeiptr>(size), BufferUsageMap<BufferUsage::Stream>::flags));
+            }
+
+            return nullptr;
+        }
+
+        /**
+         * @brief Block until commands guarded by fence are complete
+         * @param fence
+         */
+        void wait(GLsync& fence) noexcept {
+            if(!fence)
+                return;
+
+            /**** first wait flushes so fence is guaranteed to signal ****/
+            auto flags = static_cast<GLbitfield>(GL_SYNC_FLUSH_COMMANDS_BIT);
+
+            while(true) {
+                const auto status = glClientWaitSync(fence, flags, 1000000u);
+
+                if(status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+                    break;
+
+                if(status == GL_WAIT_FAILED) {
+                    Log::e(TAG, "Failed to wait for buffer fence.");
+                    break;
+                }
+
+                flags = 0u;
+            }
+
+            glDeleteSync(fence);
+
+            fence = nullptr;
+        }
+
+        /**
+         * @brief Replace fence with one placed after already submitted commands
+         * @param fence
+         */
+        void place(GLsync& fence) noexcept {
+            if(fence)
+                glDeleteSync(fence);
+
+            fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+
+        /**
+         * @brief Write range, through persistent mapping if buffer has one
+         */
+        void write(uint32_t handler, uint8_t* mapping, GLsync& fence, const void* data, size_t size, size_t offset) noexcept {
+            if(mapping) {
+                wait(fence);
+
+                std::memcpy(mapping + offset, data, size);
+            }
+            else {
+                glNamedBufferSubData(handler, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+            }
+        }
+
+        void release(uint32_t handler, uint8_t* mapping, GLsync fence) noexcept {
+            if(fence)
+                glDeleteSync(fence);
+
+            if(mapping)
+                glUnmapNamedBuffer(handler);
+
+            glDeleteBuffers(1, &handler);
+        }
+
+        /**
+         * @brief Convert indices to narrower storage type, indices must fit it
+         */
+        template<IndexType Type>
+        std::vector<typename IndexTypeMap<Type>::value_type> narrow(const std::vector<uint32_t>& data) noexcept {
+            using value_type = typename IndexTypeMap<Type>::value_type;
+
+            std::vector<value_type> result(data.size());
+
+            std::transform(data.begin(), data.end(), result.begin(), [](uint32_t value) noexcept {
+                return static_cast<value_type>(value);
+            });
+
+            return result;
+        }
+
+        inline uint32_t maxIndex(const std::vector<uint32_t>& data) noexcept {
+            return data.empty() ? 0u : *std::max_element(data.begin(), data.end());
+        }
+    }
+
+    VertexBuffer::VertexBuffer(const VertexLayout &layout, size_t count, BufferUsage usage) :
+        vLayout_{layout}, usage_{usage}
+    {
+        allocate(nullptr, count * layout.size());
+    }
+
     VertexBuffer::~VertexBuffer()
     {
-        glDeleteBuffers(1, &handler_);
+        release(handler_, mapping_, fence_);
     }
 
     void VertexBuffer::bind() const noexcept
@@ -27,119 +160,489 @@ namespace glem {
         return vLayout_;
     }
 
+    void VertexBuffer::update(const void *data, size_t size, size_t offset) noexcept
+    {
+        if(offset + size > capacity_) {
+            Log::e(TAG, "Vertex buffer update out of range: ", offset + size, " > ", capacity_);
+            return;
+        }
+
+        write(handler_, mapping_, fence_, data, size, offset);
+    }
+
+    void VertexBuffer::orphan(const void *data, size_t size) noexcept
+    {
+        if(mapping_) {
+            update(data, size);
+            return;
+        }
+
+        capacity_ = std::max(capacity_, size);
+
+        glem::allocate(handler_, capacity_, nullptr, usage_);
+        glNamedBufferSubData(handler_, 0, static_cast<GLsizeiptr>(size), data);
+    }
+
+    void VertexBuffer::fence() noexcept
+    {
+        if(mapping_)
+            place(fence_);
+    }
+
+    size_t VertexBuffer::capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    uint32_t VertexBuffer::handler() const noexcept
+    {
+        return handler_;
+    }
+
+    void VertexBuffer::allocate(const void *data, size_t size) noexcept
+    {
+        glCreateBuffers(1, &handler_);
+
+        capacity_ = size;
+        mapping_  = glem::allocate(handler_, size, data, usage_);
+    }
+
     IndexBuffer::IndexBuffer(const std::vector<uint32_t> &data, BufferUsage usage) :
-        size_{data.size()}, usage_{usage}
+        size_{data.size()}, usage_{usage}, capacity_{data.size()}
+    {
+        type_ = fit(maxIndex(data));
+
+        glCreateBuffers(1, &handler_);
+
+        mapping_ = allocate(handler_, capacity_ * stride(type_), nullptr, usage);
+
+        write(data, 0u);
+    }
+
+    IndexBuffer::IndexBuffer(size_t count, IndexType type, BufferUsage usage) :
+        usage_{usage}, type_{type}, capacity_{count}
     {
         glCreateBuffers(1, &handler_);
+
+        mapping_ = allocate(handler_, capacity_ * stride(type_), nullptr, usage);
+    }
+
+    IndexBuffer::~IndexBuffer()
+    {
+        release(handler_, mapping_, fence_);
+    }
+
+    void IndexBuffer::bind() const noexcept
+    {
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, handler_);
+    }
+
+    void IndexBuffer::unbind() const noexcept
+    {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+
+    size_t IndexBuffer::size() const noexcept
+    {
+        return size_;
+    }
+
+    void IndexBuffer::update(const std::vector<uint32_t> &data, size_t offset) noexcept
+    {
+        if(offset + data.size() > capacity_) {
+            Log::e(TAG, "Index buffer update out of range: ", offset + data.size(), " > ", capacity_);
+            return;
+        }
+
+        if(fit(maxIndex(data)) > type_) {
+            Log::e(TAG, "Indices don't fit index buffer storage type.");
+            return;
+        }
+
+        write(data, offset);
+
+        size_ = std::max(size_, offset + data.size());
+    }
+
+    void IndexBuffer::orphan(const std::vector<uint32_t> &data) noexcept
+    {
+        if(mapping_) {
+            if(data.size() > capacity_) {
+                Log::e(TAG, "Index buffer update out of range: ", data.size(), " > ", capacity_);
+                return;
+            }
+
+            if(fit(maxIndex(data)) > type_) {
+                Log::e(TAG, "Indices don't fit index buffer storage type.");
+                return;
+            }
+        }
+        else {
+            type_     = fit(maxIndex(data));
+            capacity_ = std::max(capacity_, data.size());
+
+            allocate(handler_, capacity_ * stride(type_), nullptr, usage_);
+        }
+
+        write(data, 0u);
+
+        size_ = data.size();
+    }
+
+    void IndexBuffer::fence() noexcept
+    {
+        if(mapping_)
+            place(fence_);
+    }
+
+    size_t IndexBuffer::capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    IndexType IndexBuffer::type() const noexcept
+    {
+        return type_;
+    }
+
+    IndexType IndexBuffer::fit(uint32_t value) noexcept
+    {
+        if(value <= IndexTypeMap<IndexType::UInt8>::max)
+            return IndexType::UInt8;
+
+        if(value <= IndexTypeMap<IndexType::UInt16>::max)
+            return IndexType::UInt16;
+
+        return IndexType::UInt32;
+    }
+
+    GLenum IndexBuffer::systemType(IndexType type) noexcept
+    {
+        switch (type) {
+        case IndexType::UInt8:
+            return IndexTypeMap<IndexType::UInt8>::systemType;
+        case IndexType::UInt16:
+            return IndexTypeMap<IndexType::UInt16>::systemType;
+        case IndexType::UInt32:
+            return IndexTypeMap<IndexType::UInt32>::systemType;
+        }
+
+        return GL_NONE;
+    }
+
+    size_t IndexBuffer::stride(IndexType type) noexcept
+    {
+        switch (type) {
+        case IndexType::UInt8:
+            return IndexTypeMap<IndexType::UInt8>::size;
+        case IndexType::UInt16:
+            return IndexTypeMap<IndexType::UInt16>::size;
+        case IndexType::UInt32:
+            return IndexTypeMap<IndexType::UInt32>::size;
+        }
+
+        return 0u;
+    }
+
+    uint32_t IndexBuffer::handler() const noexcept
+    {
+        return handler_;
+    }
+
+    void IndexBuffer::write(const std::vector<uint32_t> &data, size_t offset) noexcept
+    {
+        switch (type_) {
+        case IndexType::UInt8: {
+            const auto indices = narrow<IndexType::UInt8>(data);
+
+            glem::write(handler_, mapping_, fence_, indices.data(), indices.size(), offset);
+            break;
+        }
+        case IndexType::UInt16: {
+            const auto indices = narrow<IndexType::UInt16>(data);
+
+            glem::write(handler_, mapping_, fence_, indices.data(), indices.size() * sizeof (uint16_t), offset * sizeof (uint16_t));
+            break;
+        }
+        case IndexType::UInt32:
+            glem::write(handler_, mapping_, fence_, data.data(), data.size() * sizeof (uint32_t), offset * sizeof (uint32_t));
+            break;
+        }
+    }
+
+    ShaderStorageBuffer::ShaderStorageBuffer(size_t size, const void *data, BufferUsage usage) :
+        size_{size}
+    {
+        glCreateBuffers(1, &handler_);
 
         switch (usage) {
         case BufferUsage::Static:
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, data.size() * sizeof (uint32_t), data.data(), BufferUsageMap<BufferUsage::Static>::usage);
+            glNamedBufferData(handler_, static_cast<GLsizeiptr>(size), data, BufferUsageMap<BufferUsage::Static>::usage);
             break;
         case BufferUsage::Dynamic:
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, data.size() * sizeof (uint32_t), data.data(), BufferUsageMap<BufferUsage::Dynamic>::usage);
+            glNamedBufferData(handler_, static_cast<GLsizeiptr>(size), data, BufferUsageMap<BufferUsage::Dynamic>::usage);
+            break;
+        case BufferUsage::Stream:
+            glNamedBufferData(handler_, static_cast<GLsizeiptr>(size), data, BufferUsageMap<BufferUsage::Stream>::usage);
             break;
         }
-
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     }
 
-    IndexBuffer::~IndexBuffer()
+    ShaderStorageBuffer::~ShaderStorageBuffer()
     {
         glDeleteBuffers(1, &handler_);
     }
 
-    void IndexBuffer::bind() const noexcept
+    void ShaderStorageBuffer::bind() const noexcept
     {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, handler_);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, handler_);
     }
 
-    void IndexBuffer::unbind() const noexcept
+    void ShaderStorageBuffer::unbind() const noexcept
     {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
     }
 
-    size_t IndexBuffer::size() const noexcept
+    void ShaderStorageBuffer::bindBase(uint32_t index) const noexcept
+    {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, index, handler_);
+    }
+
+    void ShaderStorageBuffer::bindIndirect() const noexcept
+    {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, handler_);
+    }
+
+    void ShaderStorageBuffer::bindDispatchIndirect() const noexcept
+    {
+        glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, handler_);
+    }
+
+    void ShaderStorageBuffer::update(const void *data, size_t size, size_t offset) noexcept
+    {
+        glNamedBufferSubData(handler_, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+    }
+
+    void ShaderStorageBuffer::clear(size_t size, size_t offset) noexcept
+    {
+        glClearNamedBufferSubData(handler_, GL_R32UI, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    }
+
+    size_t ShaderStorageBuffer::size() const noexcept
     {
         return size_;
     }
 
-    VertexArray::VertexArray()
+    UniformBuffer::UniformBuffer(const UniformLayout &layout, BufferUsage usage) :
+        layout_{layout}, staging_(layout.size(), 0u)
     {
-        glCreateVertexArrays(1, &handler_);
+        if(layout_.standard() != LayoutStandard::Std140)
+            Log::e(TAG, "Uniform blocks support std140 layout only.");
+
+        glCreateBuffers(1, &handler_);
+
+        switch (usage) {
+        case BufferUsage::Static:
+            glNamedBufferData(handler_, static_cast<GLsizeiptr>(staging_.size()), staging_.data(), BufferUsageMap<BufferUsage::Static>::usage);
+            break;
+        case BufferUsage::Dynamic:
+            glNamedBufferData(handler_, static_cast<GLsizeiptr>(staging_.size()), staging_.data(), BufferUsageMap<BufferUsage::Dynamic>::usage);
+            break;
+        case BufferUsage::Stream:
+            glNamedBufferData(handler_, static_cast<GLsizeiptr>(staging_.size()), staging_.data(), BufferUsageMap<BufferUsage::Stream>::usage);
+            break;
+        }
     }
 
-    VertexArray::~VertexArray()
+    UniformBuffer::~UniformBuffer()
     {
-        glDeleteVertexArrays(1, &handler_);
+        glDeleteBuffers(1, &handler_);
     }
 
-    void VertexArray::bind() const noexcept
+    void UniformBuffer::bind() const noexcept
     {
-        glBindVertexArray(handler_);
+        glBindBuffer(GL_UNIFORM_BUFFER, handler_);
     }
 
-    void VertexArray::unbind() const noexcept
+    void UniformBuffer::unbind() const noexcept
     {
-        glBindVertexArray(0);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
     }
 
-    void VertexArray::append(std::unique_ptr<VertexBuffer> value) noexcept
+    void UniformBuffer::bindBase(uint32_t index) const noexcept
     {
-        bind();
-        value->bind();
+        glBindBufferBase(GL_UNIFORM_BUFFER, index, handler_);
+    }
 
-        const auto& layout = value->vLayout();
+    void UniformBuffer::update() noexcept
+    {
+        if(dirtyBegin_ >= dirtyEnd_)
+            return;
 
-        for(const auto& attr : layout.attributes()) {
-            glEnableVertexAttribArray(index_);
+        glNamedBufferSubData(handler_, static_cast<GLintptr>(dirtyBegin_), static_cast<GLsizeiptr>(dirtyEnd_ - dirtyBegin_), staging_.data() + dirtyBegin_);
 
-            GLenum type {GL_NONE};
+        dirtyBegin_ = dirtyEnd_ = 0u;
+    }
 
-            switch (attr.type()) {
-            case AttributeType::Vector2f:
-                type = AttributeTypeMap<AttributeType::Vector2f>::systemType;
-                break;
-            case AttributeType::Vector3f:
-                type = AttributeTypeMap<AttributeType::Vector3f>::systemType;
-                break;
+    const UniformLayout &UniformBuffer::layout() const noexcept
+    {
+        return layout_;
+    }
+
+    bool UniformBuffer::write(const std::string &member, size_t element, const void *data, size_t size) noexcept
+    {
+        for(const auto& m : layout_.members()) {
+            if(m.name() != member)
+                continue;
+
+            if(m.size() != size || element >= m.count()) {
+                Log::e(TAG, "Uniform block member type or element mismatch: ", member);
+                return false;
             }
 
-            glVertexAttribPointer(index_,
-                                  static_cast<GLint>(attr.count()),
-                                  type,
-                                  GL_FALSE,
-                                  static_cast<GLsizei>(layout.size()),
-                                  reinterpret_cast<const GLvoid*>(attr.offset()));
+            const auto offset = m.offset() + m.stride() * element;
+
+            if(std::memcmp(staging_.data() + offset, data, size) == 0)
+                return true;
+
+            std::memcpy(staging_.data() + offset, data, size);
+
+            if(dirtyBegin_ >= dirtyEnd_) {
+                dirtyBegin_ = offset;
+                dirtyEnd_   = offset + size;
+            }
+            else {
+                dirtyBegin_ = std::min(dirtyBegin_, offset);
+                dirtyEnd_   = std::max(dirtyEnd_,   offset + size);
+            }
 
-            index_++;
+            return true;
         }
 
-//        const auto& layout = value->layout();
+        Log::e(TAG, "Failed to resolve uniform block member: ", member);
 
-//        for(const auto& a : layout.layout()) {
-//            glEnableVertexAttribArray(index_);
+        return false;
+    }
+
+    /**
+     * @brief Vertex array object shared by vertex arrays with same format
+     */
+    class VertexFormat {
+    public:
+        VertexFormat() {
+            glCreateVertexArrays(1, &handler);
+        }
+
+        ~VertexFormat() {
+            if(boundVertexArray == handler)
+                boundVertexArray = 0u;
+
+            glDeleteVertexArrays(1, &handler);
+        }
+
+        VertexFormat(VertexFormat&&) = delete;
+        VertexFormat(const VertexFormat&) = delete;
+
+        VertexFormat& operator=(VertexFormat&&) = delete;
+        VertexFormat& operator=(const VertexFormat&) = delete;
 
-//            glVertexAttribPointer(index_,
-//                                  static_cast<GLint>(a.count),
-//                                  a.type,
-//                                  a.normalized ? GL_TRUE : GL_FALSE,
-//                                  static_cast<GLsizei>(layout.stride()),
-//                                  reinterpret_cast<const GLvoid*>(a.offset));
+        /**
+         * @brief Formats in use, expired entries are replaced on lookup
+         * @return
+         */
+        static std::unordered_map<uint64_t, std::weak_ptr<VertexFormat>>& registry() noexcept {
+            static std::unordered_map<uint64_t, std::weak_ptr<VertexFormat>> formats;
+
+            return formats;
+        }
 
-//            index_++;
-//        }
+        uint32_t handler {0u};
+
+        /**** array whose buffers are currently attached to binding points ****/
+        const VertexArray* owner {nullptr};
+
+        /**** binding points owner sourced from other buffers through rebind ****/
+        uint64_t rebound {0u};
+
+    };
+
+    VertexArray::VertexArray()
+    {
+
+    }
+
+    VertexArray::~VertexArray()
+    {
+        release();
+    }
+
+    void VertexArray::bind() const noexcept
+    {
+        if(!format_)
+            resolve();
+
+        const auto handler = format_->handler;
+
+        if(boundVertexArray != handler) {
+            glBindVertexArray(handler);
+
+            boundVertexArray = handler;
+        }
+
+        if(format_->owner == this) {
+            /**** restore only binding points replaced by rebind ****/
+            for(size_t i = 0; format_->rebound != 0u; ++i) {
+                if(!(format_->rebound & (1ull << i)))
+                    continue;
+
+                glVertexArrayVertexBuffer(handler,
+                                          static_cast<GLuint>(i),
+                                          array_[i]->handler(),
+                                          0,
+                                          static_cast<GLsizei>(array_[i]->vLayout().size()));
+
+                format_->rebound &= ~(1ull << i);
+            }
+
+            return;
+        }
+
+        for(size_t i = 0; i < array_.size(); ++i)
+            glVertexArrayVertexBuffer(handler,
+                                      static_cast<GLuint>(i),
+                                      array_[i]->handler(),
+                                      0,
+                                      static_cast<GLsizei>(array_[i]->vLayout().size()));
+
+        glVertexArrayElementBuffer(handler, indexBuffer_ ? indexBuffer_->handler() : 0u);
+
+        format_->owner   = this;
+        format_->rebound = 0u;
+    }
+
+    void VertexArray::unbind() const noexcept
+    {
+        glBindVertexArray(0);
+
+        boundVertexArray = 0u;
+    }
+
+    void VertexArray::append(std::unique_ptr<VertexBuffer> value, uint32_t divisor) noexcept
+    {
+        /**** format changes, array moves to another shared object on next bind ****/
+        release();
 
         array_.emplace_back(std::move(value));
+        divisors_.emplace_back(divisor);
     }
 
     void VertexArray::append(std::unique_ptr<IndexBuffer> value) noexcept
     {
-        bind();
-        value->bind();
-
         indexBuffer_ = std::move(value);
+
+        /**** element buffer isn't part of format, just force rebinding ****/
+        if(format_ && format_->owner == this)
+            format_->owner = nullptr;
     }
 
     size_t VertexArray::indexCount() const noexcept
@@ -147,4 +650,118 @@ namespace glem {
         return indexBuffer_->size();
     }
 
+    IndexType VertexArray::indexType() const noexcept
+    {
+        return indexBuffer_ ? indexBuffer_->type() : IndexType::UInt32;
+    }
+
+    size_t VertexArray::vertexBufferCount() const noexcept
+    {
+        return array_.size();
+    }
+
+    void VertexArray::rebind(size_t index, uint32_t buffer, size_t offset) const noexcept
+    {
+        if(index >= array_.size() || index >= 64u) {
+            Log::e(TAG, "Vertex buffer binding out of range: ", index);
+            return;
+        }
+
+        /**** owner keeps its binding points, only replaced one is touched ****/
+        if(!format_ || format_->owner != this) {
+            bind();
+        }
+        else if(boundVertexArray != format_->handler) {
+            glBindVertexArray(format_->handler);
+
+            boundVertexArray = format_->handler;
+        }
+
+        glVertexArrayVertexBuffer(format_->handler,
+                                  static_cast<GLuint>(index),
+                                  buffer,
+                                  static_cast<GLintptr>(offset),
+                                  static_cast<GLsizei>(array_[index]->vLayout().size()));
+
+        format_->rebound |= 1ull << index;
+    }
+
+    uint64_t VertexArray::formatKey() const noexcept
+    {
+        Hash hash;
+
+        for(size_t i = 0; i < array_.size(); ++i) {
+            const auto key = array_[i]->vLayout().key();
+
+            hash.append(&key, sizeof (key))
+                .append(divisors_[i]);
+        }
+
+        return hash.value();
+    }
+
+    void VertexArray::resolve() const noexcept
+    {
+        const auto key = formatKey();
+
+        auto& registry = VertexFormat::registry();
+
+        if(auto format = registry[key].lock()) {
+            format_ = std::move(format);
+            return;
+        }
+
+        format_ = std::make_shared<VertexFormat>();
+
+        registry[key] = format_;
+
+        const auto handler = format_->handler;
+
+        uint32_t index {0u};
+
+        for(size_t binding = 0; binding < array_.size(); ++binding) {
+            for(const auto& attr : array_[binding]->vLayout().attributes()) {
+                GLenum type {GL_NONE};
+
+                switch (attr.type()) {
+                case AttributeType::Vector2f:
+                    type = AttributeTypeMap<AttributeType::Vector2f>::systemType;
+                    break;
+                case AttributeType::Vector3f:
+                    type = AttributeTypeMap<AttributeType::Vector3f>::systemType;
+                    break;
+                case AttributeType::Vector4f:
+                    type = AttributeTypeMap<AttributeType::Vector4f>::systemType;
+                    break;
+                }
+
+                glEnableVertexArrayAttrib(handler, index);
+
+                glVertexArrayAttribFormat(handler,
+                                          index,
+                                          static_cast<GLint>(attr.count()),
+                                          type,
+                                          GL_FALSE,
+                                          static_cast<GLuint>(attr.offset()));
+
+                glVertexArrayAttribBinding(handler, index, static_cast<GLuint>(binding));
+
+                index++;
+            }
+
+            glVertexArrayBindingDivisor(handler, static_cast<GLuint>(binding), divisors_[binding]);
+        }
+    }
+
+    void VertexArray::release() noexcept
+    {
+        if(!format_)
+            return;
+
+        if(format_->owner == this)
+            format_->owner = nullptr;
+
+        format_.reset();
+    }
+
 }
@@ -2,6 +2,7 @@
 
 #include "Vertex.hpp"
 #include "Bindable.hpp"
+#include "UniformLayout.hpp"
 
 #include <glad/glad.h>
 
@@ -99,9 +100,17 @@ namespace glem {
 
     };
 
+    /**
+     * @brief Buffer usage, Stream vertex and index buffers are persistently mapped for their lifetime
+     *
+     * Stream mode is single buffered: each update waits for fence() placed after last draw
+     * reading buffer, so CPU and GPU don't overlap. Callers must call fence() after every
+     * draw that reads buffer. Per frame data is better served by FrameRingBuffer.
+     */
     enum class BufferUsage {
         Static,
-        Dynamic
+        Dynamic,
+        Stream
     };
 
     template<BufferUsage Usage> struct BufferUsageMap;
@@ -114,47 +123,29 @@ namespace glem {
         static constexpr GLint usage = GL_DYNAMIC_DRAW;
     };
 
+    template<> struct BufferUsageMap<BufferUsage::Stream> {
+        static constexpr GLint usage = GL_STREAM_DRAW;
+
+        static constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    };
+
     class VertexBuffer : public Bindable {
     public:
         template<typename T>
         VertexBuffer(const std::vector<T>& data, const InputLayout& layout, BufferUsage usage = BufferUsage::Static) :
             layout_{layout}, usage_{usage}
         {
-            glCreateBuffers(1, &handler_);
-
-            glBindBuffer(GL_ARRAY_BUFFER, handler_);
-
-            switch (usage) {
-            case BufferUsage::Static:
-                glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof (T), data.data(), BufferUsageMap<BufferUsage::Static>::usage);
-                break;
-            case BufferUsage::Dynamic:
-                glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof (T), data.data(), BufferUsageMap<BufferUsage::Dynamic>::usage);
-                break;
-            }
-
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            allocate(data.data(), data.size() * sizeof (T));
         }
 
         VertexBuffer(const VertexByteBuffer& buffer, BufferUsage usage = BufferUsage::Static) :
             vLayout_{buffer.layout()}, usage_{usage}
         {
-            glCreateBuffers(1, &handler_);
-
-            glBindBuffer(GL_ARRAY_BUFFER, handler_);
-
-            switch (usage) {
-            case BufferUsage::Static:
-                glBufferData(GL_ARRAY_BUFFER, buffer.size(), buffer.data(), BufferUsageMap<BufferUsage::Static>::usage);
-                break;
-            case BufferUsage::Dynamic:
-                glBufferData(GL_ARRAY_BUFFER, buffer.size(), buffer.data(), BufferUsageMap<BufferUsage::Dynamic>::usage);
-                break;
-            }
-
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            allocate(buffer.data(), buffer.size());
         }
 
+        VertexBuffer(const VertexLayout& layout, size_t count, BufferUsage usage = BufferUsage::Dynamic);
+
         ~VertexBuffer() override;
 
         VertexBuffer(VertexBuffer&&) = delete;
@@ -179,17 +170,118 @@ namespace glem {
          */
         const VertexLayout& vLayout() const noexcept;
 
+        /**
+         * @brief Update buffer content, Stream buffers wait for fence and write through mapping
+         * @param data   - Source data
+         * @param size   - Size of data in bytes
+         * @param offset - Offset in bytes
+         */
+        void update(const void* data, size_t size, size_t offset = 0u) noexcept;
+
+        /**
+         * @brief Update buffer content
+         * @param data   - Source elements
+         * @param offset - Offset in bytes
+         */
+        template<typename T>
+        void update(const std::vector<T>& data, size_t offset = 0u) noexcept {
+            update(data.data(), data.size() * sizeof (T), offset);
+        }
+
+        /**
+         * @brief Replace whole content, old storage is orphaned so draws still reading it don't stall
+         *
+         * Buffer grows if data doesn't fit. Stream buffers can't be orphaned, they are
+         * updated in place after fence.
+         * @param data - Source data
+         * @param size - Size of data in bytes
+         */
+        void orphan(const void* data, size_t size) noexcept;
+
+        /**
+         * @brief Fence commands reading buffer, Stream buffers require it after every draw reading them
+         *
+         * Next Stream update waits for fence, without it update may overwrite data still in use.
+         */
+        void fence() noexcept;
+
+        /**
+         * @brief Buffer capacity in bytes
+         * @return
+         */
+        size_t capacity() const noexcept;
+
+        /**
+         * @brief Buffer handler
+         * @return
+         */
+        uint32_t handler() const noexcept;
+
     private:
+        void allocate(const void* data, size_t size) noexcept;
+
         VertexLayout vLayout_;
 
         InputLayout layout_;
         BufferUsage usage_;
 
+        size_t capacity_ {0u};
+
+        uint8_t* mapping_ {nullptr};
+
+        GLsync fence_ {nullptr};
+
     };
 
+    /**
+     * @brief Index storage type
+     */
+    enum class IndexType {
+        UInt8,
+        UInt16,
+        UInt32
+    };
+
+    template<IndexType Type> struct IndexTypeMap;
+
+    template<> struct IndexTypeMap<IndexType::UInt8> {
+        using value_type = uint8_t;
+
+        static constexpr const GLenum   systemType = GL_UNSIGNED_BYTE;
+        static constexpr const size_t   size       = sizeof (GLubyte);
+        static constexpr const uint32_t max        = 0xffu;
+    };
+
+    template<> struct IndexTypeMap<IndexType::UInt16> {
+        using value_type = uint16_t;
+
+        static constexpr const GLenum   systemType = GL_UNSIGNED_SHORT;
+        static constexpr const size_t   size       = sizeof (GLushort);
+        static constexpr const uint32_t max        = 0xffffu;
+    };
+
+    template<> struct IndexTypeMap<IndexType::UInt32> {
+        using value_type = uint32_t;
+
+        static constexpr const GLenum   systemType = GL_UNSIGNED_INT;
+        static constexpr const size_t   size       = sizeof (GLuint);
+        static constexpr const uint32_t max        = 0xffffffffu;
+    };
+
+    /**
+     * @brief Index buffer, storage type is smallest one able to hold maximum index
+     */
     class IndexBuffer : public Bindable {
     public:
         IndexBuffer(const std::vector<uint32_t>& data, BufferUsage usage = BufferUsage::Static);
+
+        /**
+         * @brief Empty buffer with fixed storage type, indices are added with update
+         * @param count - Capacity in indices
+         * @param type  - Storage type
+         * @param usage
+         */
+        IndexBuffer(size_t count, IndexType type, BufferUsage usage = BufferUsage::Dynamic);
         ~IndexBuffer() override;
 
         IndexBuffer(IndexBuffer&&) = delete;
@@ -208,13 +300,214 @@ namespace glem {
          */
         size_t size() const noexcept;
 
+        /**
+         * @brief Update indices, extends index count if range passes its end, indices must fit storage type
+         * @param data   - Source indices
+         * @param offset - Offset in indices
+         */
+        void update(const std::vector<uint32_t>& data, size_t offset = 0u) noexcept;
+
+        /**
+         * @brief Replace all indices, old storage is orphaned, Stream buffers are updated in place after fence
+         *
+         * Orphaned storage picks storage type again, Stream buffers keep theirs.
+         * @param data - Source indices
+         */
+        void orphan(const std::vector<uint32_t>& data) noexcept;
+
+        /**
+         * @brief Fence commands reading buffer, Stream buffers require it after every draw reading them
+         *
+         * Next Stream update waits for fence, without it update may overwrite data still in use.
+         */
+        void fence() noexcept;
+
+        /**
+         * @brief Buffer capacity in indices
+         * @return
+         */
+        size_t capacity() const noexcept;
+
+        /**
+         * @brief Index storage type
+         * @return
+         */
+        IndexType type() const noexcept;
+
+        /**
+         * @brief Smallest storage type able to hold index
+         * @param value - Maximum index
+         * @return
+         */
+        static IndexType fit(uint32_t value) noexcept;
+
+        /**
+         * @brief GL type of index storage type
+         * @param type
+         * @return
+         */
+        static GLenum systemType(IndexType type) noexcept;
+
+        /**
+         * @brief Size of single index in bytes
+         * @param type
+         * @return
+         */
+        static size_t stride(IndexType type) noexcept;
+
+        /**
+         * @brief Buffer handler
+         * @return
+         */
+        uint32_t handler() const noexcept;
+
     private:
+        void write(const std::vector<uint32_t>& data, size_t offset) noexcept;
+
         size_t size_ {0u};
 
         BufferUsage usage_;
 
+        IndexType type_;
+
+        size_t capacity_ {0u};
+
+        uint8_t* mapping_ {nullptr};
+
+        GLsync fence_ {nullptr};
+
+    };
+
+    class ShaderStorageBuffer : public Bindable {
+    public:
+        ShaderStorageBuffer(size_t size, const void* data = nullptr, BufferUsage usage = BufferUsage::Dynamic);
+        ~ShaderStorageBuffer() override;
+
+        ShaderStorageBuffer(ShaderStorageBuffer&&) = delete;
+        ShaderStorageBuffer(const ShaderStorageBuffer&) = delete;
+
+        ShaderStorageBuffer& operator=(ShaderStorageBuffer&&) = delete;
+        ShaderStorageBuffer& operator=(const ShaderStorageBuffer&) = delete;
+
+        // Bindable interface
+        void bind() const noexcept override;
+        void unbind() const noexcept override;
+
+        /**
+         * @brief Bind buffer to indexed shader storage binding point
+         * @param index - binding point (layout(binding = index))
+         */
+        void bindBase(uint32_t index) const noexcept;
+
+        /**
+         * @brief Bind buffer as draw indirect command buffer
+         */
+        void bindIndirect() const noexcept;
+
+        /**
+         * @brief Bind buffer as dispatch indirect command buffer
+         */
+        void bindDispatchIndirect() const noexcept;
+
+        /**
+         * @brief Update buffer content
+         * @param data   - Source data
+         * @param size   - Size of data in bytes
+         * @param offset - Offset in bytes
+         */
+        void update(const void* data, size_t size, size_t offset = 0u) noexcept;
+
+        /**
+         * @brief Fill buffer range with zeros
+         * @param size   - Size of range in bytes, multiple of 4
+         * @param offset - Offset in bytes
+         */
+        void clear(size_t size, size_t offset = 0u) noexcept;
+
+        /**
+         * @brief Buffer size in bytes
+         * @return
+         */
+        size_t size() const noexcept;
+
+        /**
+         * @brief Buffer handler
+         * @return
+         */
+        uint32_t handler() const noexcept;
+
+    private:
+        size_t size_ {0u};
+
+    };
+
+    /**
+     * @brief Uniform block storage, members are staged on CPU and uploaded by single update call
+     */
+    class UniformBuffer : public Bindable {
+    public:
+        UniformBuffer(const UniformLayout& layout, BufferUsage usage = BufferUsage::Dynamic);
+        ~UniformBuffer() override;
+
+        UniformBuffer(UniformBuffer&&) = delete;
+        UniformBuffer(const UniformBuffer&) = delete;
+
+        UniformBuffer& operator=(UniformBuffer&&) = delete;
+        UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+        // Bindable interface
+        void bind() const noexcept override;
+        void unbind() const noexcept override;
+
+        /**
+         * @brief Bind buffer to indexed uniform binding point
+         * @param index - binding point (layout(binding = index))
+         */
+        void bindBase(uint32_t index) const noexcept;
+
+        /**
+         * @brief Stage member value, uploaded on next update
+         * @param member  - Member name
+         * @param value   - Value, must match member type
+         * @param element - Array element
+         * @return
+         */
+        template<typename T>
+        bool set(const std::string& member, const T& value, size_t element = 0u) noexcept {
+            return write(member, element, &value, sizeof (T));
+        }
+
+        /**
+         * @brief Upload staged members changed since last update
+         */
+        void update() noexcept;
+
+        /**
+         * @brief Block layout
+         * @return
+         */
+        const UniformLayout& layout() const noexcept;
+
+    private:
+        bool write(const std::string& member, size_t element, const void* data, size_t size) noexcept;
+
+        UniformLayout layout_;
+
+        std::vector<uint8_t> staging_;
+
+        size_t dirtyBegin_ {0u};
+        size_t dirtyEnd_   {0u};
+
     };
 
+    class VertexFormat;
+
+    /**
+     * @brief Vertex array, attribute format is described with direct state access
+     *
+     * Arrays with identical format (layouts, strides and divisors of all buffers)
+     * share one vertex array object, binding switches only buffer bindings.
+     */
     class VertexArray : public Bindable {
     public:
         VertexArray();
@@ -233,8 +526,9 @@ namespace glem {
         /**
          * @brief Append vertex buffer to array
          * @param value
+         * @param divisor - Attribute divisor (0 - per vertex, 1 - per instance)
          */
-        void append(std::unique_ptr<VertexBuffer> value) noexcept;
+        void append(std::unique_ptr<VertexBuffer> value, uint32_t divisor = 0u) noexcept;
 
         /**
          * @brief Append index buffer to array
@@ -248,12 +542,53 @@ namespace glem {
          */
         size_t indexCount() const noexcept;
 
+        /**
+         * @brief Storage type of index buffer, UInt32 if array has none
+         * @return
+         */
+        IndexType indexType() const noexcept;
+
+        /**
+         * @brief Number of appended vertex buffers, equals binding index of next one
+         * @return
+         */
+        size_t vertexBufferCount() const noexcept;
+
+        /**
+         * @brief Source binding from range of another buffer, array is bound
+         *
+         * Only replaced binding point is updated, array keeps its other bindings, and
+         * own buffer is restored on next bind.
+         *
+         * @param index  - Binding index of appended vertex buffer to replace
+         * @param buffer - Buffer handler
+         * @param offset - Offset in bytes
+         */
+        void rebind(size_t index, uint32_t buffer, size_t offset) const noexcept;
+
+        /**
+         * @brief Format key, hash of buffer layouts and divisors
+         * @return
+         */
+        uint64_t formatKey() const noexcept;
+
     private:
-        uint32_t index_ {0u};
+        /**
+         * @brief Find or create shared vertex array object for current format
+         */
+        void resolve() const noexcept;
+
+        /**
+         * @brief Release shared format, detaching buffers if they are still bound to it
+         */
+        void release() noexcept;
 
         std::vector<std::unique_ptr<VertexBuffer>> array_;
+        std::vector<uint32_t> divisors_;
 
         std::unique_ptr<IndexBuffer> indexBuffer_ {nullptr};
+
+        mutable std::shared_ptr<VertexFormat> format_ {nullptr};
     };
 
 }
@@ -0,0 +1,287 @@
+#include "Collision.hpp"
+
+#include "Particle.hpp"
+#include "Simd.hpp"
+
+#include <cfloat>
+#include <algorithm>
+
+namespace {
+    using glem::simd::Float;
+    using glem::simd::Mask;
+
+    static constexpr const float EPSILON = 1e-6f;
+
+    /**
+     * @brief Particle state of one SIMD block
+     */
+    struct Block {
+        Float px, py, pz;
+        Float vx, vy, vz;
+        Float remain;
+    };
+
+    inline Float abs(Float value) noexcept {
+        return glem::simd::max(value, glem::simd::set(0.0f) - value);
+    }
+
+    inline Float sign(Float value) noexcept {
+        return glem::simd::select(value < glem::simd::set(0.0f), glem::simd::set(-1.0f), glem::simd::set(1.0f));
+    }
+
+    /**
+     * @brief Push penetrating lanes out along normal and apply response
+     * @param distance - signed distance to collider surface
+     */
+    inline void resolve(Block& b, const glem::Colliders& colliders, Float distance, Float nx, Float ny, Float nz) noexcept {
+        using namespace glem::simd;
+
+        const auto zero = set(0.0f);
+
+        distance = distance - set(colliders.radius);
+
+        const auto hit = distance < zero;
+
+        if(!any(hit))
+            return;
+
+        const auto depth = select(hit, distance, zero);
+
+        b.px = b.px - nx * depth;
+        b.py = b.py - ny * depth;
+        b.pz = b.pz - nz * depth;
+
+        switch (colliders.response) {
+        case glem::CollisionResponse::Bounce: {
+            const auto vn       = b.vx * nx + b.vy * ny + b.vz * nz;
+            const auto incoming = hit & (vn < zero);
+
+            /**** v' = -restitution * vn * n + (1 - friction) * vt ****/
+            const auto k = set(1.0f + colliders.restitution) * vn;
+            const auto f = set(colliders.friction);
+
+            const auto tx = b.vx - vn * nx;
+            const auto ty = b.vy - vn * ny;
+            const auto tz = b.vz - vn * nz;
+
+            b.vx = select(incoming, b.vx - nx * k - tx * f, b.vx);
+            b.vy = select(incoming, b.vy - ny * k - ty * f, b.vy);
+            b.vz = select(incoming, b.vz - nz * k - tz * f, b.vz);
+            break;
+        }
+        case glem::CollisionResponse::Stick:
+            b.vx = select(hit, zero, b.vx);
+            b.vy = select(hit, zero, b.vy);
+            b.vz = select(hit, zero, b.vz);
+            break;
+        case glem::CollisionResponse::Kill:
+            b.remain = select(hit, zero, b.remain);
+            break;
+        }
+    }
+
+    inline void collide(Block& b, const glem::Colliders& colliders, const glem::PlaneCollider& plane) noexcept {
+        using namespace glem::simd;
+
+        const auto n = glm::normalize(plane.normal);
+
+        const auto nx = set(n.x);
+        const auto ny = set(n.y);
+        const auto nz = set(n.z);
+
+        resolve(b, colliders, b.px * nx + b.py * ny + b.pz * nz - set(plane.offset), nx, ny, nz);
+    }
+
+    inline void collide(Block& b, const glem::Colliders& colliders, const glem::SphereCollider& sphere) noexcept {
+        using namespace glem::simd;
+
+        const auto dx = b.px - set(sphere.center.x);
+        const auto dy = b.py - set(sphere.center.y);
+        const auto dz = b.pz - set(sphere.center.z);
+
+        const auto length  = sqrt(dx * dx + dy * dy + dz * dz);
+        const auto inverse = set(1.0f) / max(length, set(EPSILON));
+
+        resolve(b, colliders, length - set(sphere.radius), dx * inverse, dy * inverse, dz * inverse);
+    }
+
+    inline void collide(Block& b, const glem::Colliders& colliders, const glem::BoxCollider& box) noexcept {
+        using namespace glem::simd;
+
+        const auto zero = set(0.0f);
+        const auto one  = set(1.0f);
+
+        const auto center = (box.min + box.max) * 0.5f;
+        const auto half   = (box.max - box.min) * 0.5f;
+
+        const auto dx = b.px - set(center.x);
+        const auto dy = b.py - set(center.y);
+        const auto dz = b.pz - set(center.z);
+
+        const auto qx = abs(dx) - set(half.x);
+        const auto qy = abs(dy) - set(half.y);
+        const auto qz = abs(dz) - set(half.z);
+
+        /**** outside: distance to closest point, inside: distance to closest face ****/
+        const auto mx = max(qx, zero);
+        const auto my = max(qy, zero);
+        const auto mz = max(qz, zero);
+
+        const auto outer   = sqrt(mx * mx + my * my + mz * mz);
+        const auto inner   = min(max(qx, max(qy, qz)), zero);
+        const auto outside = outer > zero;
+        const auto inverse = one / max(outer, set(EPSILON));
+
+        const auto xAxis = (qx >= qy) & (qx >= qz);
+        const auto yAxis = (!xAxis) & (qy >= qz);
+        const auto zAxis = !(xAxis | yAxis);
+
+        const auto nx = select(outside, mx * inverse, select(xAxis, one, zero)) * sign(dx);
+        const auto ny = select(outside, my * inverse, select(yAxis, one, zero)) * sign(dy);
+        const auto nz = select(outside, mz * inverse, select(zAxis, one, zero)) * sign(dz);
+
+        resolve(b, colliders, outer + inner, nx, ny, nz);
+    }
+
+    inline void collide(Block& b, const glem::Colliders& colliders, const glem::SdfVolume& volume) noexcept {
+        using namespace glem::simd;
+
+        /**** grid lookups are gathers, sample lanes one by one and resolve on full register ****/
+        alignas(32) float x[WIDTH];
+        alignas(32) float y[WIDTH];
+        alignas(32) float z[WIDTH];
+
+        alignas(32) float distance[WIDTH];
+        alignas(32) float nx[WIDTH];
+        alignas(32) float ny[WIDTH];
+        alignas(32) float nz[WIDTH];
+
+        store(x, b.px);
+        store(y, b.py);
+        store(z, b.pz);
+
+        for(size_t lane = 0; lane < WIDTH; ++lane) {
+            const glm::vec3 point {x[lane], y[lane], z[lane]};
+
+            glm::vec3 gradient {0.0f};
+
+            distance[lane] = volume.contains(point) ? volume.sample(point, gradient) : FLT_MAX;
+
+            gradient /= std::max(glm::length(gradient), EPSILON);
+
+            nx[lane] = gradient.x;
+            ny[lane] = gradient.y;
+            nz[lane] = gradient.z;
+        }
+
+        resolve(b, colliders, load(distance), load(nx), load(ny), load(nz));
+    }
+}
+
+namespace glem {
+
+    SdfVolume::SdfVolume(const glm::vec3 &min, const glm::vec3 &max, const glm::uvec3 &resolution, const std::function<float (const glm::vec3 &)> &distance) :
+        min_{min}, max_{max}, resolution_{glm::max(resolution, glm::uvec3{2u})}
+    {
+        const auto cells = glm::vec3{resolution_ - 1u};
+
+        scale_ = cells / (max_ - min_);
+
+        distances_.resize(static_cast<size_t>(resolution_.x) * resolution_.y * resolution_.z);
+
+        auto out = distances_.begin();
+
+        for(uint32_t k = 0; k < resolution_.z; ++k)
+            for(uint32_t j = 0; j < resolution_.y; ++j)
+                for(uint32_t i = 0; i < resolution_.x; ++i)
+                    *out++ = distance(min_ + glm::vec3{i, j, k} / scale_);
+    }
+
+    float SdfVolume::sample(const glm::vec3 &point, glm::vec3 &gradient) const noexcept
+    {
+        const auto u    = glm::clamp((point - min_) * scale_, glm::vec3{0.0f}, glm::vec3{resolution_ - 1u});
+        const auto cell = glm::min(glm::uvec3{u}, resolution_ - 2u);
+        const auto f    = u - glm::vec3{cell};
+
+        auto at = [this](uint32_t i, uint32_t j, uint32_t k) noexcept {
+            return distances_[(static_cast<size_t>(k) * resolution_.y + j) * resolution_.x + i];
+        };
+
+        const auto c000 = at(cell.x,      cell.y,      cell.z     );
+        const auto c100 = at(cell.x + 1u, cell.y,      cell.z     );
+        const auto c010 = at(cell.x,      cell.y + 1u, cell.z     );
+        const auto c110 = at(cell.x + 1u, cell.y + 1u, cell.z     );
+        const auto c001 = at(cell.x,      cell.y,      cell.z + 1u);
+        const auto c101 = at(cell.x + 1u, cell.y,      cell.z + 1u);
+        const auto c011 = at(cell.x,      cell.y + 1u, cell.z + 1u);
+        const auto c111 = at(cell.x + 1u, cell.y + 1u, cell.z + 1u);
+
+        const auto x00 = glm::mix(c000, c100, f.x);
+        const auto x10 = glm::mix(c010, c110, f.x);
+        const auto x01 = glm::mix(c001, c101, f.x);
+        const auto x11 = glm::mix(c011, c111, f.x);
+
+        const auto y0 = glm::mix(x00, x10, f.y);
+        const auto y1 = glm::mix(x01, x11, f.y);
+
+        /**** analytic derivative of trilinear interpolation, scaled from cell to world units ****/
+        gradient.x = glm::mix(glm::mix(c100 - c000, c110 - c010, f.y), glm::mix(c101 - c001, c111 - c011, f.y), f.z);
+        gradient.y = glm::mix(x10 - x00, x11 - x01, f.z);
+        gradient.z = y1 - y0;
+        gradient  *= scale_;
+
+        return glm::mix(y0, y1, f.z);
+    }
+
+    bool SdfVolume::contains(const glm::vec3 &point) const noexcept
+    {
+        return glm::all(glm::greaterThanEqual(point, min_)) && glm::all(glm::lessThanEqual(point, max_));
+    }
+
+    void collide(ParticlePool &pool, size_t begin, size_t end, const Colliders &colliders) noexcept
+    {
+        if(colliders.planes.empty() && colliders.spheres.empty() && colliders.boxes.empty() && !colliders.volume)
+            return;
+
+        auto px = pool.positionX.data();
+        auto py = pool.positionY.data();
+        auto pz = pool.positionZ.data();
+
+        auto vx = pool.velocityX.data();
+        auto vy = pool.velocityY.data();
+        auto vz = pool.velocityZ.data();
+
+        auto remain = pool.remain.data();
+
+        for(auto i = begin; i < end; i += simd::WIDTH) {
+            Block b {
+                simd::load(px + i), simd::load(py + i), simd::load(pz + i),
+                simd::load(vx + i), simd::load(vy + i), simd::load(vz + i),
+                simd::load(remain + i)
+            };
+
+            for(const auto& plane : colliders.planes)
+                ::collide(b, colliders, plane);
+
+            for(const auto& sphere : colliders.spheres)
+                ::collide(b, colliders, sphere);
+
+            for(const auto& box : colliders.boxes)
+                ::collide(b, colliders, box);
+
+            if(colliders.volume)
+                ::collide(b, colliders, *colliders.volume);
+
+            simd::store(px + i, b.px);
+            simd::store(py + i, b.py);
+            simd::store(pz + i, b.pz);
+
+            simd::store(vx + i, b.vx);
+            simd::store(vy + i, b.vy);
+            simd::store(vz + i, b.vz);
+
+            simd::store(remain + i, b.remain);
+        }
+    }
+
+}
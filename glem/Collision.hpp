@@ -0,0 +1,130 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <memory>
+#include <vector>
+#include <functional>
+
+namespace glem {
+
+    class ParticlePool;
+
+    /**
+     * @brief What happens to particle touching collider
+     */
+    enum class CollisionResponse {
+        Bounce,
+        Stick,
+        Kill
+    };
+
+    /**
+     * @brief Half space dot(normal, p) < offset is solid
+     */
+    struct PlaneCollider {
+        glm::vec3 normal {0.0f, 1.0f, 0.0f};
+        float     offset {0.0f};
+    };
+
+    /**
+     * @brief Solid sphere
+     */
+    struct SphereCollider {
+        glm::vec3 center {0.0f};
+        float     radius {1.0f};
+    };
+
+    /**
+     * @brief Solid axis aligned box
+     */
+    struct BoxCollider {
+        glm::vec3 min {-0.5f};
+        glm::vec3 max { 0.5f};
+    };
+
+    /**
+     * @brief Signed distance field baked into regular grid, negative inside
+     *
+     * Distance and gradient are trilinear over grid cells, particles outside
+     * of volume bounds never collide with it.
+     */
+    class SdfVolume {
+    public:
+        /**
+         * @brief Bake distance function into grid
+         * @param min        - volume bounds
+         * @param max
+         * @param resolution - samples per axis, at least 2
+         * @param distance   - signed distance function, sampled at grid nodes
+         */
+        SdfVolume(const glm::vec3& min, const glm::vec3& max, const glm::uvec3& resolution, const std::function<float(const glm::vec3&)>& distance);
+        ~SdfVolume() = default;
+
+        /**
+         * @brief Trilinear distance and gradient at point
+         * @param point    - point inside volume bounds
+         * @param gradient - unnormalized distance gradient
+         * @return Signed distance
+         */
+        float sample(const glm::vec3& point, glm::vec3& gradient) const noexcept;
+
+        /**
+         * @brief Check if point lies inside volume bounds
+         * @param point
+         * @return
+         */
+        bool contains(const glm::vec3& point) const noexcept;
+
+    private:
+        glm::vec3  min_        {0.0f};
+        glm::vec3  max_        {0.0f};
+        glm::vec3  scale_      {0.0f};
+        glm::uvec3 resolution_ {0u};
+
+        std::vector<float> distances_;
+
+    };
+
+    /**
+     * @brief Collision stage settings shared by particle emitters
+     */
+    struct Colliders {
+        std::vector<PlaneCollider>  planes;
+        std::vector<SphereCollider> spheres;
+        std::vector<BoxCollider>    boxes;
+
+        std::shared_ptr<const SdfVolume> volume {nullptr};
+
+        CollisionResponse response {CollisionResponse::Bounce};
+
+        /**
+         * @brief Fraction of normal velocity kept after bounce
+         */
+        float restitution {0.5f};
+
+        /**
+         * @brief Fraction of tangential velocity removed by bounce
+         */
+        float friction {0.1f};
+
+        /**
+         * @brief Particle collision radius
+         */
+        float radius {0.0f};
+    };
+
+    /**
+     * @brief Push particles in range [begin, end) out of colliders and apply collision response
+     *
+     * Runs on full SIMD registers, range end must be multiple of 8 or pool count,
+     * padding slots past pool count are processed and left unused.
+     *
+     * @param pool
+     * @param begin     - multiple of 8
+     * @param end
+     * @param colliders
+     */
+    void collide(ParticlePool& pool, size_t begin, size_t end, const Colliders& colliders) noexcept;
+
+}
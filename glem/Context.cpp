@@ -1,5 +1,8 @@
 #include "Context.hpp"
 #include "Window.hpp"
+#include "Buffer.hpp"
+#include "Shader.hpp"
+#include "FrameRingBuffer.hpp"
 
 #include "Log.hpp"
 
@@ -12,6 +15,8 @@
 namespace {
     static constexpr const char* TAG = "Context";
 
+    static constexpr const size_t TRANSIENT_SIZE = 4u * 1024u * 1024u;
+
     void APIENTRY gl_debug_callback(GLenum        source,
                                     GLenum        type,
                                     GLuint        id,
@@ -113,6 +118,17 @@ namespace glem {
         Log::d(TAG, reinterpret_cast<const char*>(renderer));
         Log::d(TAG, "OpenGL: ", reinterpret_cast<const char*>(version));
 
+        if(Shader::enableParallelCompile(reinterpret_cast<Shader::ProcLoader>(glfwGetProcAddress)))
+            Log::d(TAG, "Parallel shader compilation enabled.");
+
+        transient_ = std::make_unique<FrameRingBuffer>(TRANSIENT_SIZE);
+
+        if(!transient_->valid()) {
+            Log::w(TAG, "Transient ring buffer isn't available.");
+
+            transient_.reset();
+        }
+
         /**** viewport ****/
         {
             glViewport(0, 0, parent_.width(), parent_.height());
@@ -128,18 +144,78 @@ namespace glem {
 
     void Context::beginFrame(const glm::vec4 &color) const noexcept
     {
+        if(transient_)
+            transient_->begin();
+
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         glClearColor(color.r, color.g, color.b, color.a);
     }
 
     void Context::endFrame() const noexcept
     {
+        if(transient_)
+            transient_->end();
+
         glfwSwapBuffers(parent_.handler());
     }
 
-    void Context::renderIndexed(size_t size, GLenum topology) noexcept
+    FrameRingBuffer *Context::transient() const noexcept
+    {
+        return transient_.get();
+    }
+
+    void Context::renderIndexed(size_t size, IndexType type, GLenum topology) noexcept
+    {
+        glDrawElements(topology, static_cast<GLsizei>(size), IndexBuffer::systemType(type), reinterpret_cast<void*>(0));
+    }
+
+    void Context::renderIndexedBaseVertex(size_t size, IndexType type, size_t first, int32_t baseVertex, GLenum topology) noexcept
+    {
+        glDrawElementsBaseVertex(topology,
+                                 static_cast<GLsizei>(size),
+                                 IndexBuffer::systemType(type),
+                                 reinterpret_cast<void*>(first * IndexBuffer::stride(type)),
+                                 baseVertex);
+    }
+
+    void Context::renderIndexedInstanced(size_t size, IndexType type, size_t instances, GLenum topology) noexcept
+    {
+        glDrawElementsInstanced(topology, static_cast<GLsizei>(size), IndexBuffer::systemType(type), reinterpret_cast<void*>(0), static_cast<GLsizei>(instances));
+    }
+
+    void Context::renderIndexedIndirect(IndexType type, size_t offset, GLenum topology) noexcept
+    {
+        glDrawElementsIndirect(topology, IndexBuffer::systemType(type), reinterpret_cast<void*>(offset));
+    }
+
+    void Context::dispatch(uint32_t x, uint32_t y, uint32_t z) noexcept
+    {
+        glDispatchCompute(x, y, z);
+    }
+
+    void Context::dispatchIndirect(size_t offset) noexcept
+    {
+        glDispatchComputeIndirect(static_cast<GLintptr>(offset));
+    }
+
+    uint32_t Context::workGroups(size_t invocations, uint32_t size) noexcept
+    {
+        return static_cast<uint32_t>((invocations + size - 1u) / size);
+    }
+
+    void Context::memoryBarrier(GLbitfield barriers) noexcept
+    {
+        glMemoryBarrier(barriers);
+    }
+
+    void Context::memoryBarrierByRegion(GLbitfield barriers) noexcept
+    {
+        glMemoryBarrierByRegion(barriers);
+    }
+
+    void Context::setPatchVertices(uint32_t count) noexcept
     {
-        glDrawElements(topology, static_cast<GLsizei>(size), GL_UNSIGNED_INT, reinterpret_cast<void*>(0));
+        glPatchParameteri(GL_PATCH_VERTICES, static_cast<GLint>(count));
     }
 
 }
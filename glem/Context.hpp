@@ -4,9 +4,14 @@
 
 #include <glad/glad.h>
 
+#include <memory>
+
 namespace glem {
 
     class Window;
+    class FrameRingBuffer;
+
+    enum class IndexType;
 
     class Context {
     public:
@@ -30,16 +35,93 @@ namespace glem {
          */
         void endFrame() const noexcept;
 
+        /**
+         * @brief Transient ring buffer for per frame data, recycled after frames in flight
+         * @return nullptr if persistent mapping isn't available
+         */
+        FrameRingBuffer* transient() const noexcept;
+
         /**
          * @brief Render indexed
          * @param size     - number of indicies
+         * @param type     - index storage type of bound index buffer
          * @param topology - topology
          */
-        void renderIndexed(size_t size, GLenum topology = GL_TRIANGLES) noexcept;
+        void renderIndexed(size_t size, IndexType type, GLenum topology = GL_TRIANGLES) noexcept;
+
+        /**
+         * @brief Render range of indices, offset by base vertex, from shared buffers
+         * @param size       - number of indicies
+         * @param type       - index storage type of bound index buffer
+         * @param first      - first index
+         * @param baseVertex - value added to each index
+         * @param topology   - topology
+         */
+        void renderIndexedBaseVertex(size_t size, IndexType type, size_t first, int32_t baseVertex, GLenum topology = GL_TRIANGLES) noexcept;
+
+        /**
+         * @brief Render indexed instanced
+         * @param size      - number of indicies
+         * @param type      - index storage type of bound index buffer
+         * @param instances - number of instances
+         * @param topology  - topology
+         */
+        void renderIndexedInstanced(size_t size, IndexType type, size_t instances, GLenum topology = GL_TRIANGLES) noexcept;
+
+        /**
+         * @brief Render indexed with parameters sourced from bound draw indirect buffer
+         * @param type     - index storage type of bound index buffer
+         * @param offset   - offset of DrawElementsIndirectCommand in buffer
+         * @param topology - topology
+         */
+        void renderIndexedIndirect(IndexType type, size_t offset = 0u, GLenum topology = GL_TRIANGLES) noexcept;
+
+        /**
+         * @brief Dispatch compute work groups of bound program
+         * @param x - number of work groups in X dimension
+         * @param y - number of work groups in Y dimension
+         * @param z - number of work groups in Z dimension
+         */
+        void dispatch(uint32_t x, uint32_t y = 1u, uint32_t z = 1u) noexcept;
+
+        /**
+         * @brief Dispatch compute work groups with counts sourced from bound dispatch indirect buffer
+         * @param offset - offset of DispatchIndirectCommand {x, y, z} in buffer
+         */
+        void dispatchIndirect(size_t offset = 0u) noexcept;
+
+        /**
+         * @brief Work groups needed to cover invocations
+         * @param invocations - total invocations
+         * @param size        - work group size
+         * @return
+         */
+        static uint32_t workGroups(size_t invocations, uint32_t size) noexcept;
+
+        /**
+         * @brief Order memory transactions issued by previous shader invocations
+         * @param barriers - GL_*_BARRIER_BIT mask
+         */
+        void memoryBarrier(GLbitfield barriers) noexcept;
+
+        /**
+         * @brief Order memory transactions of previous fragment shader invocations,
+         *        only within same framebuffer region, cheaper on tiled GPUs
+         * @param barriers - GL_*_BARRIER_BIT mask, subset valid for region barriers
+         */
+        void memoryBarrierByRegion(GLbitfield barriers) noexcept;
+
+        /**
+         * @brief Set number of vertices per patch for GL_PATCHES topology
+         * @param count
+         */
+        void setPatchVertices(uint32_t count) noexcept;
 
     private:
         Window& parent_;
 
+        std::unique_ptr<FrameRingBuffer> transient_ {nullptr};
+
     };
 
 }
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <initializer_list>
+
+namespace glem {
+
+    template<typename T>
+    struct CurveKey {
+        float time {0.0f};
+
+        T value {};
+    };
+
+    /**
+     * @brief Piecewise linear curve over normalized time [0, 1]
+     *
+     * Keys are baked into fixed size lookup table on construction, so
+     * evaluation costs two table reads regardless of number of keys.
+     */
+    template<typename T>
+    class Curve {
+    public:
+        static constexpr const size_t RESOLUTION = 64u;
+
+        Curve(const T& value = T{}) noexcept {
+            table_.fill(value);
+        }
+
+        Curve(std::initializer_list<CurveKey<T>> keys) noexcept :
+            Curve(std::vector<CurveKey<T>>{keys})
+        {
+
+        }
+
+        Curve(std::vector<CurveKey<T>> keys) noexcept {
+            if(keys.empty()) {
+                table_.fill(T{});
+                return;
+            }
+
+            std::stable_sort(keys.begin(), keys.end(), [](const auto& a, const auto& b) {
+                return a.time < b.time;
+            });
+
+            size_t segment {0u};
+
+            for(size_t i = 0; i < RESOLUTION; ++i) {
+                const auto t = static_cast<float>(i) / static_cast<float>(RESOLUTION - 1u);
+
+                while(segment + 1u < keys.size() && keys[segment + 1u].time < t)
+                    ++segment;
+
+                const auto& a = keys[segment];
+                const auto& b = keys[std::min(segment + 1u, keys.size() - 1u)];
+
+                if(t <= a.time || b.time <= a.time)
+                    table_[i] = t <= a.time ? a.value : b.value;
+                else
+                    table_[i] = glm::mix(a.value, b.value, glm::clamp((t - a.time) / (b.time - a.time), 0.0f, 1.0f));
+            }
+        }
+
+        ~Curve() = default;
+
+        /**
+         * @brief Evaluate curve
+         * @param t - normalized time, clamped to [0, 1]
+         * @return
+         */
+        inline T operator()(float t) const noexcept {
+            const auto x = glm::clamp(t, 0.0f, 1.0f) * static_cast<float>(RESOLUTION - 1u);
+            const auto i = std::min(static_cast<size_t>(x), RESOLUTION - 2u);
+
+            return glm::mix(table_[i], table_[i + 1u], x - static_cast<float>(i));
+        }
+
+        /**
+         * @brief Baked lookup table
+         * @return
+         */
+        inline const std::array<T, RESOLUTION>& table() const noexcept {
+            return table_;
+        }
+
+    private:
+        std::array<T, RESOLUTION> table_;
+
+    };
+
+}
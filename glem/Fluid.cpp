@@ -0,0 +1,257 @@
+#include "Fluid.hpp"
+
+#include "Particle.hpp"
+#include "ThreadPool.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+#include <glm/gtc/constants.hpp>
+
+namespace {
+    static constexpr const float EPSILON = 1e-6f;
+
+    static constexpr const uint32_t MIN_BUCKETS = 64u;
+
+    inline uint32_t powerOfTwo(size_t value) noexcept {
+        uint32_t result = MIN_BUCKETS;
+
+        while(result < value)
+            result <<= 1u;
+
+        return result;
+    }
+}
+
+namespace glem {
+
+    SphSolver::SphSolver(const FluidDescriptor &descriptor) :
+        descriptor_{descriptor}
+    {
+        const auto h = std::max(descriptor_.smoothingRadius, EPSILON);
+
+        h2_       = h * h;
+        inverseH_ = 1.0f / h;
+
+        /**** Muller et al. 2003 kernels: poly6 density, spiky pressure gradient, viscosity laplacian ****/
+        poly6_     =  315.0f / (64.0f * glm::pi<float>() * std::pow(h, 9.0f));
+        spiky_     = -45.0f  / (glm::pi<float>() * std::pow(h, 6.0f));
+        laplacian_ =  45.0f  / (glm::pi<float>() * std::pow(h, 6.0f));
+    }
+
+    void SphSolver::step(ParticlePool &pool, float deltaTime, ThreadPool *threads, size_t chunk) noexcept
+    {
+        const auto count = pool.count();
+
+        if(count == 0u)
+            return;
+
+        auto run = [threads, chunk, count](const std::function<void(size_t, size_t)>& function) {
+            if(threads)
+                threads->parallelFor(count, chunk, function);
+            else
+                function(0u, count);
+        };
+
+        build(pool, threads, chunk);
+
+        run([this](size_t begin, size_t end) {
+            computeDensity(begin, end);
+        });
+
+        run([this, &pool, deltaTime](size_t begin, size_t end) {
+            computeForces(pool, begin, end, deltaTime);
+        });
+    }
+
+    void SphSolver::build(ParticlePool &pool, ThreadPool *threads, size_t chunk) noexcept
+    {
+        const auto count   = pool.count();
+        const auto buckets = powerOfTwo(2u * count);
+
+        mask_ = buckets - 1u;
+
+        buckets_.resize(count);
+        order_.resize(count);
+
+        x_.resize(count);
+        y_.resize(count);
+        z_.resize(count);
+
+        vx_.resize(count);
+        vy_.resize(count);
+        vz_.resize(count);
+
+        density_.resize(count);
+        pressure_.resize(count);
+
+        const auto px = pool.positionX.data();
+        const auto py = pool.positionY.data();
+        const auto pz = pool.positionZ.data();
+
+        auto hash = [this, px, py, pz](size_t begin, size_t end) {
+            for(auto i = begin; i < end; ++i)
+                buckets_[i] = bucket(cell(px[i], py[i], pz[i]));
+        };
+
+        if(threads)
+            threads->parallelFor(count, chunk, hash);
+        else
+            hash(0u, count);
+
+        /**** counting sort by bucket ****/
+        cellStart_.assign(buckets + 1u, 0u);
+
+        for(size_t i = 0; i < count; ++i)
+            ++cellStart_[buckets_[i] + 1u];
+
+        for(uint32_t b = 0; b < buckets; ++b)
+            cellStart_[b + 1u] += cellStart_[b];
+
+        cursor_.assign(cellStart_.begin(), cellStart_.end() - 1);
+
+        for(size_t i = 0; i < count; ++i) {
+            const auto k = cursor_[buckets_[i]]++;
+
+            order_[k] = static_cast<uint32_t>(i);
+        }
+
+        /**** copy state in cell order, neighbor loops read it linearly ****/
+        const auto vx = pool.velocityX.data();
+        const auto vy = pool.velocityY.data();
+        const auto vz = pool.velocityZ.data();
+
+        auto gather = [this, px, py, pz, vx, vy, vz](size_t begin, size_t end) {
+            for(auto k = begin; k < end; ++k) {
+                const auto i = order_[k];
+
+                x_[k] = px[i];
+                y_[k] = py[i];
+                z_[k] = pz[i];
+
+                vx_[k] = vx[i];
+                vy_[k] = vy[i];
+                vz_[k] = vz[i];
+            }
+        };
+
+        if(threads)
+            threads->parallelFor(count, chunk, gather);
+        else
+            gather(0u, count);
+    }
+
+    void SphSolver::computeDensity(size_t begin, size_t end) noexcept
+    {
+        const auto mass = descriptor_.mass;
+
+        for(auto k = begin; k < end; ++k) {
+            auto density = 0.0f;
+
+            forEachNeighbor(k, [&](size_t, float r2) {
+                const auto d = h2_ - r2;
+
+                density += d * d * d;
+            });
+
+            density_[k]  = std::max(density * mass * poly6_, EPSILON);
+            pressure_[k] = std::max(descriptor_.stiffness * (density_[k] - descriptor_.restDensity), 0.0f);
+        }
+    }
+
+    void SphSolver::computeForces(ParticlePool &pool, size_t begin, size_t end, float deltaTime) noexcept
+    {
+        const auto mass = descriptor_.mass;
+        const auto h    = descriptor_.smoothingRadius;
+
+        auto vx = pool.velocityX.data();
+        auto vy = pool.velocityY.data();
+        auto vz = pool.velocityZ.data();
+
+        for(auto k = begin; k < end; ++k) {
+            glm::vec3 pressure  {0.0f};
+            glm::vec3 viscosity {0.0f};
+
+            forEachNeighbor(k, [&](size_t j, float r2) {
+                if(j == k)
+                    return;
+
+                const auto r = std::sqrt(r2);
+
+                const glm::vec3 delta {x_[k] - x_[j], y_[k] - y_[j], z_[k] - z_[j]};
+
+                /**** coincident particles are pushed apart along arbitrary axis ****/
+                const auto direction = r > EPSILON ? delta / r : glm::vec3{0.0f, 1.0f, 0.0f};
+                const auto w         = h - r;
+
+                pressure  -= direction * ((pressure_[k] + pressure_[j]) / (2.0f * density_[j]) * spiky_ * w * w);
+                viscosity += glm::vec3{vx_[j] - vx_[k], vy_[j] - vy_[k], vz_[j] - vz_[k]} * (laplacian_ * w / density_[j]);
+            });
+
+            const auto acceleration = (pressure + viscosity * descriptor_.viscosity) * (mass / density_[k]) + descriptor_.gravity;
+
+            const auto i = order_[k];
+
+            vx[i] += acceleration.x * deltaTime;
+            vy[i] += acceleration.y * deltaTime;
+            vz[i] += acceleration.z * deltaTime;
+        }
+    }
+
+    uint32_t SphSolver::bucket(const glm::ivec3 &cell) const noexcept
+    {
+        const auto hash = (static_cast<uint32_t>(cell.x) * 73856093u) ^
+                          (static_cast<uint32_t>(cell.y) * 19349663u) ^
+                          (static_cast<uint32_t>(cell.z) * 83492791u);
+
+        return hash & mask_;
+    }
+
+    glm::ivec3 SphSolver::cell(float x, float y, float z) const noexcept
+    {
+        return {
+            static_cast<int>(std::floor(x * inverseH_)),
+            static_cast<int>(std::floor(y * inverseH_)),
+            static_cast<int>(std::floor(z * inverseH_))
+        };
+    }
+
+    template<typename Function>
+    void SphSolver::forEachNeighbor(size_t k, Function &&function) const noexcept
+    {
+        const auto x = x_[k];
+        const auto y = y_[k];
+        const auto z = z_[k];
+
+        const auto center = cell(x, y, z);
+
+        /**** different cells may share bucket, visit every bucket once ****/
+        uint32_t visited[27];
+        size_t   count = 0u;
+
+        for(int dz = -1; dz <= 1; ++dz) {
+            for(int dy = -1; dy <= 1; ++dy) {
+                for(int dx = -1; dx <= 1; ++dx) {
+                    const auto b = bucket(center + glm::ivec3{dx, dy, dz});
+
+                    if(std::find(visited, visited + count, b) != visited + count)
+                        continue;
+
+                    visited[count++] = b;
+
+                    for(auto j = cellStart_[b]; j < cellStart_[b + 1u]; ++j) {
+                        const auto ex = x - x_[j];
+                        const auto ey = y - y_[j];
+                        const auto ez = z - z_[j];
+
+                        const auto r2 = ex * ex + ey * ey + ez * ez;
+
+                        if(r2 < h2_)
+                            function(static_cast<size_t>(j), r2);
+                    }
+                }
+            }
+        }
+    }
+
+}
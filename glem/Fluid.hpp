@@ -0,0 +1,107 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace glem {
+
+    class ParticlePool;
+    class ThreadPool;
+
+    /**
+     * @brief Smoothed particle hydrodynamics settings
+     */
+    struct FluidDescriptor {
+        /**
+         * @brief Kernel support radius, also spatial hash cell size
+         */
+        float smoothingRadius {1.0f};
+
+        float mass        {1.0f};
+        float restDensity {8.0f};
+        float stiffness   {200.0f};
+        float viscosity   {2.0f};
+
+        glm::vec3 gravity {0.0f, -9.81f, 0.0f};
+    };
+
+    /**
+     * @brief SPH step over particle pool: density, pressure and viscosity from neighbors
+     *
+     * Neighbors are found through spatial hash of uniform grid cells rebuilt every
+     * step with counting sort, particle positions and velocities are copied in
+     * cell order so neighbor loops walk memory linearly. Density and force passes
+     * run on disjoint chunks of sorted particles and may be split across threads.
+     */
+    class SphSolver {
+    public:
+        SphSolver(const FluidDescriptor& descriptor);
+        ~SphSolver() = default;
+
+        SphSolver(SphSolver&&) = delete;
+        SphSolver(const SphSolver&) = delete;
+
+        SphSolver& operator=(SphSolver&&) = delete;
+        SphSolver& operator=(const SphSolver&) = delete;
+
+        /**
+         * @brief Accelerate alive particles by fluid forces and gravity
+         * @param pool
+         * @param deltaTime
+         * @param threads   - optional thread pool
+         * @param chunk     - particles per task
+         */
+        void step(ParticlePool& pool, float deltaTime, ThreadPool* threads = nullptr, size_t chunk = 4096u) noexcept;
+
+    private:
+        /**
+         * @brief Hash particles into grid cells and counting sort them by cell
+         */
+        void build(ParticlePool& pool, ThreadPool* threads, size_t chunk) noexcept;
+
+        void computeDensity(size_t begin, size_t end) noexcept;
+
+        void computeForces(ParticlePool& pool, size_t begin, size_t end, float deltaTime) noexcept;
+
+        uint32_t bucket(const glm::ivec3& cell) const noexcept;
+
+        glm::ivec3 cell(float x, float y, float z) const noexcept;
+
+        /**
+         * @brief Call function(j, r2) for every sorted particle j within smoothing radius of sorted particle k
+         */
+        template<typename Function>
+        void forEachNeighbor(size_t k, Function&& function) const noexcept;
+
+        FluidDescriptor descriptor_;
+
+        float h2_          {0.0f};
+        float inverseH_    {0.0f};
+        float poly6_       {0.0f};
+        float spiky_       {0.0f};
+        float laplacian_   {0.0f};
+
+        uint32_t mask_ {0u};
+
+        std::vector<uint32_t> buckets_;   // per pool particle
+        std::vector<uint32_t> cellStart_; // per bucket, first sorted particle, last entry is count
+        std::vector<uint32_t> cursor_;
+        std::vector<uint32_t> order_;     // sorted -> pool index
+
+        std::vector<float> x_;
+        std::vector<float> y_;
+        std::vector<float> z_;
+
+        std::vector<float> vx_;
+        std::vector<float> vy_;
+        std::vector<float> vz_;
+
+        std::vector<float> density_;
+        std::vector<float> pressure_;
+
+    };
+
+}
@@ -0,0 +1,157 @@
+#include "ForceField.hpp"
+
+#include "Particle.hpp"
+#include "Simd.hpp"
+
+namespace {
+    using glem::simd::Float;
+
+    /**
+     * @brief Noise value and its partial derivatives
+     */
+    struct Noise {
+        Float value;
+        Float dx, dy, dz;
+    };
+
+    inline Float fract(Float value) noexcept {
+        return value - glem::simd::floor(value);
+    }
+
+    /**
+     * @brief Lattice hash in [-1, 1), float only so it maps to SSE2 without integer multiply
+     */
+    inline Float hash(Float x, Float y, Float z) noexcept {
+        using namespace glem::simd;
+
+        const auto scale  = set(0.1031f);
+        const auto offset = set(31.32f);
+
+        x = fract(x * scale);
+        y = fract(y * scale);
+        z = fract(z * scale);
+
+        const auto d = x * (z + offset) + y * (y + offset) + z * (x + offset);
+
+        x = x + d;
+        y = y + d;
+        z = z + d;
+
+        return fract((x + y) * z) * set(2.0f) - set(1.0f);
+    }
+
+    inline Float mix(Float a, Float b, Float t) noexcept {
+        return a + (b - a) * t;
+    }
+
+    /**
+     * @brief Value noise with smoothstep interpolation and analytic gradient
+     */
+    inline Noise noise(Float x, Float y, Float z) noexcept {
+        using namespace glem::simd;
+
+        const auto one   = set(1.0f);
+        const auto two   = set(2.0f);
+        const auto three = set(3.0f);
+        const auto six   = set(6.0f);
+
+        const auto ix = floor(x);
+        const auto iy = floor(y);
+        const auto iz = floor(z);
+
+        const auto fx = x - ix;
+        const auto fy = y - iy;
+        const auto fz = z - iz;
+
+        const auto ux = fx * fx * (three - two * fx);
+        const auto uy = fy * fy * (three - two * fy);
+        const auto uz = fz * fz * (three - two * fz);
+
+        const auto jx = ix + one;
+        const auto jy = iy + one;
+        const auto jz = iz + one;
+
+        const auto c000 = hash(ix, iy, iz);
+        const auto c100 = hash(jx, iy, iz);
+        const auto c010 = hash(ix, jy, iz);
+        const auto c110 = hash(jx, jy, iz);
+        const auto c001 = hash(ix, iy, jz);
+        const auto c101 = hash(jx, iy, jz);
+        const auto c011 = hash(ix, jy, jz);
+        const auto c111 = hash(jx, jy, jz);
+
+        const auto x00 = mix(c000, c100, ux);
+        const auto x10 = mix(c010, c110, ux);
+        const auto x01 = mix(c001, c101, ux);
+        const auto x11 = mix(c011, c111, ux);
+
+        const auto y0 = mix(x00, x10, uy);
+        const auto y1 = mix(x01, x11, uy);
+
+        return {
+            mix(y0, y1, uz),
+            mix(mix(c100 - c000, c110 - c010, uy), mix(c101 - c001, c111 - c011, uy), uz) * six * fx * (one - fx),
+            mix(x10 - x00, x11 - x01, uz) * six * fy * (one - fy),
+            (y1 - y0) * six * fz * (one - fz)
+        };
+    }
+}
+
+namespace glem {
+
+    void applyForceField(ParticlePool &pool, size_t begin, size_t end, float deltaTime, float time, const CurlNoiseField &field) noexcept
+    {
+        const auto px = pool.positionX.data();
+        const auto py = pool.positionY.data();
+        const auto pz = pool.positionZ.data();
+
+        auto vx = pool.velocityX.data();
+        auto vy = pool.velocityY.data();
+        auto vz = pool.velocityZ.data();
+
+        const auto scroll = simd::set(time * field.speed);
+
+        for(auto i = begin; i < end; i += simd::WIDTH) {
+            const auto x = simd::load(px + i);
+            const auto y = simd::load(py + i);
+            const auto z = simd::load(pz + i);
+
+            auto cx = simd::set(0.0f);
+            auto cy = simd::set(0.0f);
+            auto cz = simd::set(0.0f);
+
+            auto frequency = field.frequency;
+            auto amplitude = 1.0f;
+
+            for(uint32_t octave = 0; octave < field.octaves; ++octave) {
+                const auto f = simd::set(frequency);
+
+                const auto sx = x * f + scroll;
+                const auto sy = y * f + scroll;
+                const auto sz = z * f + scroll;
+
+                /**** three decorrelated potential components, offsets keep them apart on lattice ****/
+                const auto n1 = noise(sx,                     sy,                     sz);
+                const auto n2 = noise(sx + simd::set(31.4f), sy + simd::set(47.2f), sz + simd::set(12.9f));
+                const auto n3 = noise(sx - simd::set(19.1f), sy + simd::set(33.4f), sz + simd::set(71.3f));
+
+                /**** curl of (n1, n2, n3), chain rule brings frequency into derivative ****/
+                const auto scale = simd::set(amplitude * frequency);
+
+                cx = cx + (n3.dy - n2.dz) * scale;
+                cy = cy + (n1.dz - n3.dx) * scale;
+                cz = cz + (n2.dx - n1.dy) * scale;
+
+                frequency *= 2.0f;
+                amplitude *= 0.5f;
+            }
+
+            const auto step = simd::set(field.strength * deltaTime);
+
+            simd::store(vx + i, simd::load(vx + i) + cx * step);
+            simd::store(vy + i, simd::load(vy + i) + cy * step);
+            simd::store(vz + i, simd::load(vz + i) + cz * step);
+        }
+    }
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace glem {
+
+    class ParticlePool;
+
+    /**
+     * @brief Turbulent flow from curl of 3D value noise potential, divergence free
+     */
+    struct CurlNoiseField {
+        /**
+         * @brief Noise lattice cells per world unit of first octave
+         */
+        float frequency {0.25f};
+
+        /**
+         * @brief Acceleration scale
+         */
+        float strength {4.0f};
+
+        /**
+         * @brief Noise domain scroll per second
+         */
+        float speed {0.5f};
+
+        /**
+         * @brief Octaves, each doubles frequency and halves amplitude
+         */
+        uint32_t octaves {2u};
+    };
+
+    /**
+     * @brief Accelerate particles in range [begin, end) by curl noise field
+     *
+     * Noise is evaluated for full SIMD register of particles at once, range end
+     * must be multiple of 8 or pool count, padding slots past pool count are
+     * processed and left unused.
+     *
+     * @param pool
+     * @param begin     - multiple of 8
+     * @param end
+     * @param deltaTime
+     * @param time      - field time, scrolls noise domain
+     * @param field
+     */
+    void applyForceField(ParticlePool& pool, size_t begin, size_t end, float deltaTime, float time, const CurlNoiseField& field) noexcept;
+
+}
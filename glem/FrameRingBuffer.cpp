@@ -0,0 +1,178 @@
+#include "FrameRingBuffer.hpp"
+
+#include "Log.hpp"
+
+#include <algorithm>
+
+namespace {
+    static constexpr const char* TAG = "FrameRingBuffer";
+
+    static constexpr const GLbitfield FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    static constexpr const GLuint64 TIMEOUT = 1000000u;
+
+    inline size_t align(size_t value, size_t alignment) noexcept {
+        return (value + alignment - 1u) / alignment * alignment;
+    }
+
+    inline size_t query(GLenum name) noexcept {
+        GLint value {0};
+
+        glGetIntegerv(name, &value);
+
+        return value > 0 ? static_cast<size_t>(value) : glem::FrameRingBuffer::ALIGNMENT;
+    }
+}
+
+namespace glem {
+
+    FrameRingBuffer::FrameRingBuffer(size_t size, size_t frames) :
+        uniformAlignment_{query(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT)},
+        storageAlignment_{query(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT)},
+        fences_(frames, nullptr)
+    {
+        /**** slot bases stay aligned for every target ****/
+        size_ = align(size, std::max(uniformAlignment_, storageAlignment_));
+
+        glCreateBuffers(1, &handler_);
+
+        const auto total = static_cast<GLsizeiptr>(size_ * frames);
+
+        glNamedBufferStorage(handler_, total, nullptr, FLAGS);
+
+        mapping_ = static_cast<uint8_t*>(glMapNamedBufferRange(handler_, 0, total, FLAGS));
+
+        if(!mapping_)
+            Log::e(TAG, "Failed to map ring buffer.");
+    }
+
+    FrameRingBuffer::~FrameRingBuffer()
+    {
+        for(auto fence : fences_)
+            if(fence)
+                glDeleteSync(fence);
+
+        if(mapping_)
+            glUnmapNamedBuffer(handler_);
+
+        glDeleteBuffers(1, &handler_);
+    }
+
+    bool FrameRingBuffer::valid() const noexcept
+    {
+        return mapping_ != nullptr;
+    }
+
+    void FrameRingBuffer::begin() noexcept
+    {
+        head_ = 0u;
+
+        auto& fence = fences_[frame_];
+
+        if(!fence)
+            return;
+
+        /**** first wait flushes so fence is guaranteed to signal ****/
+        auto flags = static_cast<GLbitfield>(GL_SYNC_FLUSH_COMMANDS_BIT);
+
+        while(true) {
+            const auto status = glClientWaitSync(fence, flags, TIMEOUT);
+
+            if(status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+                break;
+
+            if(status == GL_WAIT_FAILED) {
+                Log::e(TAG, "Failed to wait for frame fence.");
+                break;
+            }
+
+            flags = 0u;
+        }
+
+        glDeleteSync(fence);
+
+        fence = nullptr;
+    }
+
+    void FrameRingBuffer::end() noexcept
+    {
+        auto& fence = fences_[frame_];
+
+        if(fence)
+            glDeleteSync(fence);
+
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        frame_ = (frame_ + 1u) % fences_.size();
+        head_  = 0u;
+    }
+
+    std::optional<FrameRingBuffer::Allocation> FrameRingBuffer::allocate(size_t size, size_t alignment) noexcept
+    {
+        if(!mapping_)
+            return std::nullopt;
+
+        const auto base   = frame_ * size_;
+        const auto offset = align(base + head_, alignment);
+
+        if(offset + size > base + size_) {
+            if(overflows_++ == 0u)
+                Log::w(TAG, "Frame slot exhausted, requested ", size, " bytes, ", size_ - head_, " left, further overflows are only counted.");
+
+            return std::nullopt;
+        }
+
+        head_ = offset + size - base;
+
+        Allocation allocation;
+
+        allocation.data   = mapping_ + offset;
+        allocation.offset = offset;
+        allocation.size   = size;
+
+        return allocation;
+    }
+
+    std::optional<FrameRingBuffer::Allocation> FrameRingBuffer::allocateRange(GLenum target, size_t size) noexcept
+    {
+        return allocate(size, alignment(target));
+    }
+
+    void FrameRingBuffer::bindRange(GLenum target, uint32_t index, const Allocation &allocation) const noexcept
+    {
+        glBindBufferRange(target, index, handler_, static_cast<GLintptr>(allocation.offset), static_cast<GLsizeiptr>(allocation.size));
+    }
+
+    size_t FrameRingBuffer::alignment(GLenum target) const noexcept
+    {
+        switch (target) {
+        case GL_UNIFORM_BUFFER:
+            return uniformAlignment_;
+        case GL_SHADER_STORAGE_BUFFER:
+            return storageAlignment_;
+        }
+
+        return ALIGNMENT;
+    }
+
+    size_t FrameRingBuffer::size() const noexcept
+    {
+        return size_;
+    }
+
+    size_t FrameRingBuffer::used() const noexcept
+    {
+        return head_;
+    }
+
+    size_t FrameRingBuffer::overflows() const noexcept
+    {
+        return overflows_;
+    }
+
+    uint32_t FrameRingBuffer::handler() const noexcept
+    {
+        return handler_;
+    }
+
+}
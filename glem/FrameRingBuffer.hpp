@@ -0,0 +1,147 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <vector>
+#include <cstring>
+#include <optional>
+
+namespace glem {
+
+    /**
+     * @brief Per frame transient allocator on top of one persistently mapped buffer
+     *
+     * Buffer is split into frame slots used round robin. Allocations live until end of
+     * frame, fence placed at end of frame keeps CPU from writing into slot again until
+     * GPU has finished reading it.
+     */
+    class FrameRingBuffer {
+    public:
+        static constexpr const size_t FRAMES    = 3u;
+        static constexpr const size_t ALIGNMENT = 16u;
+
+        /**
+         * @brief Sub allocation, valid until end of frame
+         */
+        struct Allocation {
+            uint8_t* data {nullptr};
+
+            size_t offset {0u}; // Offset in buffer in bytes
+            size_t size   {0u};
+        };
+
+        FrameRingBuffer(size_t size, size_t frames = FRAMES);
+        ~FrameRingBuffer();
+
+        FrameRingBuffer(FrameRingBuffer&&) = delete;
+        FrameRingBuffer(const FrameRingBuffer&) = delete;
+
+        FrameRingBuffer& operator=(FrameRingBuffer&&) = delete;
+        FrameRingBuffer& operator=(const FrameRingBuffer&) = delete;
+
+        /**
+         * @brief Check if buffer storage is mapped
+         * @return
+         */
+        bool valid() const noexcept;
+
+        /**
+         * @brief Begin frame, waits until GPU is done with current slot
+         */
+        void begin() noexcept;
+
+        /**
+         * @brief End frame, fences commands submitted during frame and moves to next slot
+         */
+        void end() noexcept;
+
+        /**
+         * @brief Allocate range in current slot
+         * @param size      - Size in bytes
+         * @param alignment - Offset alignment in bytes
+         * @return Empty if slot is exhausted
+         */
+        std::optional<Allocation> allocate(size_t size, size_t alignment = ALIGNMENT) noexcept;
+
+        /**
+         * @brief Allocate range in current slot aligned for bindRange
+         * @param target - GL_UNIFORM_BUFFER or GL_SHADER_STORAGE_BUFFER
+         * @param size   - Size in bytes
+         * @return Empty if slot is exhausted
+         */
+        std::optional<Allocation> allocateRange(GLenum target, size_t size) noexcept;
+
+        /**
+         * @brief Allocate range in current slot and copy data into it
+         * @param data      - Source elements
+         * @param alignment - Offset alignment in bytes
+         * @return Empty if slot is exhausted
+         */
+        template<typename T>
+        std::optional<Allocation> push(const std::vector<T>& data, size_t alignment = ALIGNMENT) noexcept {
+            auto allocation = allocate(data.size() * sizeof (T), alignment);
+
+            if(allocation)
+                std::memcpy(allocation->data, data.data(), allocation->size);
+
+            return allocation;
+        }
+
+        /**
+         * @brief Bind allocation to indexed target, allocation must come from allocateRange with same target
+         * @param target     - GL_UNIFORM_BUFFER or GL_SHADER_STORAGE_BUFFER
+         * @param index      - Binding point
+         * @param allocation
+         */
+        void bindRange(GLenum target, uint32_t index, const Allocation& allocation) const noexcept;
+
+        /**
+         * @brief Offset alignment required to bind allocation to target
+         * @param target - GL_UNIFORM_BUFFER or GL_SHADER_STORAGE_BUFFER
+         * @return
+         */
+        size_t alignment(GLenum target) const noexcept;
+
+        /**
+         * @brief Size of single frame slot in bytes
+         * @return
+         */
+        size_t size() const noexcept;
+
+        /**
+         * @brief Bytes allocated in current frame
+         * @return
+         */
+        size_t used() const noexcept;
+
+        /**
+         * @brief Number of allocations failed because slot was exhausted, only first one is logged
+         * @return
+         */
+        size_t overflows() const noexcept;
+
+        /**
+         * @brief Buffer handler
+         * @return
+         */
+        uint32_t handler() const noexcept;
+
+    private:
+        uint32_t handler_ {0u};
+
+        size_t uniformAlignment_ {ALIGNMENT};
+        size_t storageAlignment_ {ALIGNMENT};
+
+        size_t overflows_ {0u};
+
+        uint8_t* mapping_ {nullptr};
+
+        size_t size_  {0u};
+        size_t head_  {0u};
+        size_t frame_ {0u};
+
+        std::vector<GLsync> fences_;
+
+    };
+
+}
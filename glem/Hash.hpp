@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace glem {
+
+    /**
+     * @brief Incremental 64 bit FNV-1a hash, stable across runs and platforms
+     */
+    class Hash {
+    public:
+        static constexpr const uint64_t OFFSET = 0xcbf29ce484222325ull;
+        static constexpr const uint64_t PRIME  = 0x100000001b3ull;
+
+        Hash() = default;
+        ~Hash() = default;
+
+        /**
+         * @brief Append raw bytes
+         * @param data
+         * @param size
+         * @return
+         */
+        inline Hash& append(const void* data, size_t size) noexcept {
+            const auto bytes = static_cast<const uint8_t*>(data);
+
+            for(size_t i = 0; i < size; ++i) {
+                value_ ^= bytes[i];
+                value_ *= PRIME;
+            }
+
+            return (*this);
+        }
+
+        /**
+         * @brief Append string prefixed with its length, so concatenations don't collide
+         * @param value
+         * @return
+         */
+        inline Hash& append(std::string_view value) noexcept {
+            const uint64_t length = value.size();
+
+            append(&length, sizeof (length));
+
+            return append(value.data(), value.size());
+        }
+
+        /**
+         * @brief Append integral value
+         * @param value
+         * @return
+         */
+        inline Hash& append(uint32_t value) noexcept {
+            return append(&value, sizeof (value));
+        }
+
+        /**
+         * @brief Hash value
+         * @return
+         */
+        inline uint64_t value() const noexcept {
+            return value_;
+        }
+
+    private:
+        uint64_t value_ {OFFSET};
+
+    };
+
+}
@@ -0,0 +1,114 @@
+#include "MeshArena.hpp"
+
+#include "Log.hpp"
+#include "Mesh.hpp"
+#include "Buffer.hpp"
+#include "Context.hpp"
+
+#include <algorithm>
+
+namespace {
+    static constexpr const char* TAG = "MeshArena";
+}
+
+namespace glem {
+
+    MeshArena::MeshArena(size_t vertices, size_t indices) :
+        vertices_{vertices}, indices_{indices}
+    {
+
+    }
+
+    MeshArena::~MeshArena()
+    {
+
+    }
+
+    std::optional<MeshHandle> MeshArena::append(const IndexedTriangleList &mesh) noexcept
+    {
+        const auto& layout = mesh.buffer.layout();
+
+        const auto vertexCount = mesh.buffer.count();
+        const auto indexCount  = mesh.indices.size();
+
+        if(vertexCount == 0u || indexCount == 0u) {
+            Log::e(TAG, "Unable to append empty mesh.");
+            return std::nullopt;
+        }
+
+        auto& pool = allocate(layout, vertexCount, indexCount);
+
+        MeshHandle handle;
+
+        handle.pool       = static_cast<uint32_t>(&pool - pools_.data());
+        handle.baseVertex = static_cast<int32_t>(pool.vertexCount);
+        handle.firstIndex = static_cast<uint32_t>(pool.indexCount);
+        handle.count      = static_cast<uint32_t>(indexCount);
+
+        pool.vertices->update(mesh.buffer.data(), mesh.buffer.size(), pool.vertexCount * layout.size());
+        pool.indices->update(mesh.indices, pool.indexCount);
+
+        pool.vertexCount += vertexCount;
+        pool.indexCount  += indexCount;
+
+        return handle;
+    }
+
+    void MeshArena::bind(const MeshHandle &handle) const noexcept
+    {
+        pools_[handle.pool].array->bind();
+    }
+
+    void MeshArena::render(Context &context, const MeshHandle &handle, GLenum topology) const noexcept
+    {
+        const auto& array = pools_[handle.pool].array;
+
+        array->bind();
+
+        context.renderIndexedBaseVertex(handle.count, array->indexType(), handle.firstIndex, handle.baseVertex, topology);
+    }
+
+    std::shared_ptr<VertexArray> MeshArena::vertexArray(const MeshHandle &handle) const noexcept
+    {
+        return pools_[handle.pool].array;
+    }
+
+    size_t MeshArena::size() const noexcept
+    {
+        return pools_.size();
+    }
+
+    MeshArena::Pool &MeshArena::allocate(const VertexLayout &layout, size_t vertices, size_t indices) noexcept
+    {
+        const auto key = layout.key();
+
+        for(auto& pool : pools_)
+            if(pool.key == key &&
+               pool.vertexCount + vertices <= pool.vertexCapacity &&
+               pool.indexCount  + indices  <= pool.indexCapacity)
+                return pool;
+
+        /**** meshes larger than default capacity get pool of their own ****/
+        Pool pool;
+
+        pool.key            = key;
+        pool.vertexCapacity = std::max(vertices_, vertices);
+        pool.indexCapacity  = std::max(indices_,  indices);
+
+        /**** indices are local to mesh, so pool vertex capacity bounds them ****/
+        const auto indexType = IndexBuffer::fit(static_cast<uint32_t>(pool.vertexCapacity - 1u));
+
+        auto vertexBuffer = std::make_unique<VertexBuffer>(layout, pool.vertexCapacity, BufferUsage::Static);
+        auto indexBuffer  = std::make_unique<IndexBuffer>(pool.indexCapacity, indexType, BufferUsage::Static);
+
+        pool.vertices = vertexBuffer.get();
+        pool.indices  = indexBuffer.get();
+
+        pool.array = std::make_shared<VertexArray>();
+        pool.array->append(std::move(vertexBuffer));
+        pool.array->append(std::move(indexBuffer));
+
+        return pools_.emplace_back(std::move(pool));
+    }
+
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <memory>
+#include <vector>
+#include <optional>
+
+namespace glem {
+
+    class Context;
+    class VertexArray;
+    class VertexBuffer;
+    class IndexBuffer;
+    class VertexLayout;
+
+    struct IndexedTriangleList;
+
+    /**
+     * @brief Mesh ranges in arena buffers
+     */
+    struct MeshHandle {
+        uint32_t pool       {0u};
+        int32_t  baseVertex {0};
+        uint32_t firstIndex {0u};
+        uint32_t count      {0u};
+    };
+
+    /**
+     * @brief Packs many meshes into shared vertex and index buffers
+     *
+     * Meshes are suballocated from pools of large buffers, pools are grouped by vertex
+     * format and all pools of one format share vertex array object, so consecutive
+     * draws of different meshes don't change state. Ranges are released with arena.
+     */
+    class MeshArena {
+    public:
+        static constexpr const size_t VERTICES = 65536u;
+        static constexpr const size_t INDICES  = 3u * 65536u;
+
+        /**
+         * @param vertices - Vertex capacity of each pool
+         * @param indices  - Index capacity of each pool
+         */
+        MeshArena(size_t vertices = VERTICES, size_t indices = INDICES);
+        ~MeshArena();
+
+        MeshArena(MeshArena&&) = delete;
+        MeshArena(const MeshArena&) = delete;
+
+        MeshArena& operator=(MeshArena&&) = delete;
+        MeshArena& operator=(const MeshArena&) = delete;
+
+        /**
+         * @brief Append mesh, new pool is created when none of its format has room
+         * @param mesh
+         * @return Empty if mesh is empty
+         */
+        std::optional<MeshHandle> append(const IndexedTriangleList& mesh) noexcept;
+
+        /**
+         * @brief Bind vertex array of mesh pool
+         * @param handle
+         */
+        void bind(const MeshHandle& handle) const noexcept;
+
+        /**
+         * @brief Bind mesh pool and render mesh
+         * @param context
+         * @param handle
+         * @param topology
+         */
+        void render(Context& context, const MeshHandle& handle, GLenum topology = GL_TRIANGLES) const noexcept;
+
+        /**
+         * @brief Vertex array of mesh pool
+         * @param handle
+         * @return
+         */
+        std::shared_ptr<VertexArray> vertexArray(const MeshHandle& handle) const noexcept;
+
+        /**
+         * @brief Number of pools
+         * @return
+         */
+        size_t size() const noexcept;
+
+    private:
+        struct Pool {
+            uint64_t key {0u};
+
+            std::shared_ptr<VertexArray> array {nullptr};
+
+            VertexBuffer* vertices {nullptr};
+            IndexBuffer*  indices  {nullptr};
+
+            size_t vertexCount    {0u};
+            size_t vertexCapacity {0u};
+            size_t indexCount     {0u};
+            size_t indexCapacity  {0u};
+        };
+
+        Pool& allocate(const VertexLayout& layout, size_t vertices, size_t indices) noexcept;
+
+        size_t vertices_ {VERTICES};
+        size_t indices_  {INDICES};
+
+        std::vector<Pool> pools_;
+
+    };
+
+}
@@ -1,9 +1,8 @@
 #include "Particle.hpp"
 
+#include <cmath>
 #include <random>
-
-#define _USE_MATH_DEFINES
-#include <math.h>
+#include <algorithm>
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/glm.hpp>
@@ -12,36 +11,260 @@
 
 #include "Buffer.hpp"
 #include "Context.hpp"
+#include "FrameRingBuffer.hpp"
+#include "Shader.hpp"
 #include "Program.hpp"
+#include "ThreadPool.hpp"
+
+#include "Log.hpp"
+#include "Simd.hpp"
+#include "Collision.hpp"
 
 namespace {
     const std::string TAG = "Particle";
 
-    static uint32_t index {0u};
+    static constexpr const uint32_t WORK_GROUP_SIZE = 256u;
+
+    static constexpr const char* SIMULATION_CS = R"glsl(
+                         #version 450
+                         layout(local_size_x = 256) in;
+                         struct Particle {
+                            vec4 position;
+                            vec4 velocity;
+                            vec4 rotation;
+                         };
+                         layout(std430, binding = 0) buffer Particles {
+                            Particle particles[];
+                         };
+                         layout(std430, binding = 1) writeonly buffer Alive {
+                            uint alive[];
+                         };
+                         layout(std430, binding = 2) buffer Command {
+                            uint count;
+                            uint instanceCount;
+                            uint firstIndex;
+                            int  baseVertex;
+                            uint baseInstance;
+                         };
+                         layout(std430, binding = 3) readonly buffer Curves {
+                            vec4  color[64];
+                            float size[64];
+                            float velocityScale[64];
+                         };
+                         uniform float uDeltaTime;
+                         uniform int uCapacity;
+                         uniform int uSpawnOffset;
+                         uniform int uSpawnCount;
+                         uniform int uSeed;
+                         uniform vec4  uSpawnRange; // xy - velocity, zw - rotation
+                         uniform float uLife;
+                         uint hash(uint value) {
+                            uint state = value * 747796405u + 2891336453u;
+                            uint word  = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+                            return (word >> 22u) ^ word;
+                         }
+                         float random(inout uint state) {
+                            state = hash(state);
+                            return float(state) / 4294967295.0f;
+                         }
+                         void main() {
+                            uint id       = gl_GlobalInvocationID.x;
+                            uint capacity = uint(uCapacity);
+                            if(id >= capacity)
+                                return;
+                            Particle p = particles[id];
+                            if((id + capacity - uint(uSpawnOffset)) % capacity < uint(uSpawnCount)) {
+                                uint state = hash(id ^ hash(uint(uSeed)));
+                                p.velocity.x = mix(uSpawnRange.x, uSpawnRange.y, random(state)) * (random(state) - 0.5f);
+                                p.velocity.y = mix(uSpawnRange.x, uSpawnRange.y, random(state)) * (random(state) - 0.5f);
+                                p.velocity.z = mix(uSpawnRange.x, uSpawnRange.y, random(state)) * (random(state) - 0.5f);
+                                p.rotation.x = mix(uSpawnRange.z, uSpawnRange.w, random(state)) * (random(state) - 0.5f);
+                                p.rotation.y = mix(uSpawnRange.z, uSpawnRange.w, random(state)) * (random(state) - 0.5f);
+                                p.rotation.z = mix(uSpawnRange.z, uSpawnRange.w, random(state)) * (random(state) - 0.5f);
+                                p.position   = vec4(0.0f, 0.0f, 0.0f, uLife);
+                                p.velocity.w = uLife;
+                                p.rotation.w = 1.0f;
+                            }
+                            else if(p.rotation.w > 0.0f) {
+                                if(p.position.w <= 0.0f) {
+                                    p.rotation.w = 0.0f;
+                                }
+                                else {
+                                    float x = clamp(1.0f - p.position.w / p.velocity.w, 0.0f, 1.0f) * 63.0f;
+                                    int   i = min(int(x), 62);
+                                    float step = mix(velocityScale[i], velocityScale[i + 1], x - float(i)) * uDeltaTime;
+                                    p.position.w   -= uDeltaTime;
+                                    p.position.xyz += p.velocity.xyz * step;
+                                    p.rotation.xyz += p.velocity.xyz * step;
+                                }
+                            }
+                            particles[id] = p;
+                            if(p.rotation.w > 0.0f)
+                                alive[atomicAdd(instanceCount, 1u)] = id;
+                         }
+                         )glsl";
+}
+
+namespace glem {
+
+    namespace {
+        inline size_t padded(size_t value) noexcept {
+            return (value + 7u) & ~size_t{7u};
+        }
+    }
+
+    ParticlePool::ParticlePool(size_t capacity) :
+        positionX(padded(capacity)),
+        positionY(padded(capacity)),
+        positionZ(padded(capacity)),
+        velocityX(padded(capacity)),
+        velocityY(padded(capacity)),
+        velocityZ(padded(capacity)),
+        rotationX(padded(capacity)),
+        rotationY(padded(capacity)),
+        rotationZ(padded(capacity)),
+        life(padded(capacity)),
+        remain(padded(capacity)),
+        capacity_{capacity}
+    {
+
+    }
+
+    size_t ParticlePool::capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    size_t ParticlePool::count() const noexcept
+    {
+        return count_;
+    }
+
+    std::optional<size_t> ParticlePool::emplace() noexcept
+    {
+        if(count_ == capacity_)
+            return {};
+
+        return count_++;
+    }
+
+    size_t ParticlePool::emplace(size_t count) noexcept
+    {
+        const auto taken = std::min(count, capacity_ - count_);
+
+        count_ += taken;
+
+        return taken;
+    }
+
+    void ParticlePool::kill(size_t index) noexcept
+    {
+        const auto last = --count_;
+
+        if(index == last)
+            return;
 
-    /**** random ****/
-    static std::mt19937 device;
+        positionX[index] = positionX[last];
+        positionY[index] = positionY[last];
+        positionZ[index] = positionZ[last];
 
-    template<typename T>
-    static T random(T&& v1, T&& v2) noexcept {
-        if constexpr (std::is_same_v<float, std::decay_t<T>>) {
-            std::uniform_real_distribution d(std::forward<T>(v1), std::forward<T>(v2));
+        velocityX[index] = velocityX[last];
+        velocityY[index] = velocityY[last];
+        velocityZ[index] = velocityZ[last];
 
-            return static_cast<float>(d(device));
+        rotationX[index] = rotationX[last];
+        rotationY[index] = rotationY[last];
+        rotationZ[index] = rotationZ[last];
+
+        life[index]   = life[last];
+        remain[index] = remain[last];
+    }
+
+    void ParticlePool::compact() noexcept
+    {
+        for(size_t i = 0; i < count_;) {
+            if(remain[i] <= 0.0f)
+                kill(i);
+            else
+                ++i;
         }
-        else {
-            std::uniform_int_distribution d(std::forward<T>(v1), std::forward<T>(v2));
+    }
+
+    void integrate(ParticlePool &pool, size_t begin, size_t end, float deltaTime, const float *velocityScale) noexcept
+    {
+        /**** raw stream pointers, SIMD stores may alias vector internals otherwise ****/
+        auto px = pool.positionX.data();
+        auto py = pool.positionY.data();
+        auto pz = pool.positionZ.data();
+
+        auto rx = pool.rotationX.data();
+        auto ry = pool.rotationY.data();
+        auto rz = pool.rotationZ.data();
+
+        const auto vx = pool.velocityX.data();
+        const auto vy = pool.velocityY.data();
+        const auto vz = pool.velocityZ.data();
+
+        auto remain = pool.remain.data();
+
+        auto i = begin;
+
+        const auto dt = simd::set(deltaTime);
+
+        for(; i + simd::WIDTH <= end; i += simd::WIDTH) {
+            const auto step = velocityScale ? simd::load(velocityScale + i) * dt : dt;
+
+            const auto dx = simd::load(vx + i) * step;
+            const auto dy = simd::load(vy + i) * step;
+            const auto dz = simd::load(vz + i) * step;
 
-            return d(device);
+            simd::store(px + i, simd::load(px + i) + dx);
+            simd::store(py + i, simd::load(py + i) + dy);
+            simd::store(pz + i, simd::load(pz + i) + dz);
+
+            simd::store(rx + i, simd::load(rx + i) + dx);
+            simd::store(ry + i, simd::load(ry + i) + dy);
+            simd::store(rz + i, simd::load(rz + i) + dz);
+
+            simd::store(remain + i, simd::load(remain + i) - dt);
+        }
+
+        for(; i < end; ++i) {
+            const auto step = velocityScale ? velocityScale[i] * deltaTime : deltaTime;
+
+            px[i] += vx[i] * step;
+            py[i] += vy[i] * step;
+            pz[i] += vz[i] * step;
+
+            rx[i] += vx[i] * step;
+            ry[i] += vy[i] * step;
+            rz[i] += vz[i] * step;
+
+            remain[i] -= deltaTime;
         }
     }
-}
 
-namespace glem {
+    ParticleEmitter::ParticleEmitter(const EmitterDescriptor &descriptor) :
+        ParticleEmitter{descriptor, (static_cast<uint64_t>(std::random_device()()) << 32) | std::random_device()()}
+    {
+
+    }
 
-    ParticleEmitter::ParticleEmitter()
+    ParticleEmitter::ParticleEmitter(const EmitterDescriptor &descriptor, uint64_t seed) :
+        descriptor_{descriptor}, pool_{descriptor.capacity}, random_{seed}, scratch_(pool_.capacity())
     {
-        device.seed(std::random_device()());
+        descriptor_.chunkSize = padded(std::max<size_t>(descriptor_.chunkSize, 1u));
+
+        const auto& velocity = descriptor_.velocityOverLife.table();
+
+        constantVelocity_ = std::all_of(velocity.begin(), velocity.end(), [](float value) {
+            return value == 1.0f;
+        });
+
+        instances_.reserve(pool_.capacity());
+
+        if(descriptor_.fluid)
+            fluid_ = std::make_unique<SphSolver>(*descriptor_.fluid);
     }
 
     ParticleEmitter::~ParticleEmitter()
@@ -51,73 +274,506 @@ namespace glem {
 
     void ParticleEmitter::update(float deltaTime) noexcept
     {
-        for(auto& p : pool_) {
-            if(!p.alive)
-                continue;
+        prepare(deltaTime);
+
+        if(fluid_)
+            fluid_->step(pool_, deltaTime);
+
+        advance(0u, pool_.count(), deltaTime);
+    }
+
+    void ParticleEmitter::update(float deltaTime, ThreadPool &threads) noexcept
+    {
+        prepare(deltaTime);
+
+        if(fluid_)
+            fluid_->step(pool_, deltaTime, &threads, descriptor_.chunkSize);
+
+        threads.parallelFor(pool_.count(), descriptor_.chunkSize, [this, deltaTime](size_t begin, size_t end) {
+            advance(begin, end, deltaTime);
+        });
+    }
+
+    void ParticleEmitter::update(const std::vector<ParticleEmitter*> &emitters, float deltaTime, ThreadPool &threads) noexcept
+    {
+        threads.parallelFor(emitters.size(), 1u, [&emitters, deltaTime](size_t begin, size_t end) {
+            for(auto i = begin; i < end; ++i)
+                emitters[i]->update(deltaTime);
+        });
+    }
+
+    void ParticleEmitter::prepare(float deltaTime) noexcept
+    {
+        sorted_ = false;
+
+        time_ += deltaTime;
+
+        pool_.compact();
+
+        if(descriptor_.spawnRate > 0.0f) {
+            spawnDebt_ += descriptor_.spawnRate * deltaTime;
+
+            const auto count = static_cast<size_t>(spawnDebt_);
+
+            spawnDebt_ -= static_cast<float>(count);
+
+            spawn(count);
+        }
+    }
+
+    void ParticleEmitter::advance(size_t begin, size_t end, float deltaTime) noexcept
+    {
+        if(descriptor_.curlNoise)
+            applyForceField(pool_, begin, end, deltaTime, time_, *descriptor_.curlNoise);
 
-            if(p.remain <= 0.0f) {
-                p.alive = false;
-                continue;
-            }
+        if(constantVelocity_) {
+            integrate(pool_, begin, end, deltaTime);
+        }
+        else {
+            auto scale = scratch_.data();
 
-            p.remain -= deltaTime;
+            for(auto i = begin; i < end; ++i)
+                scale[i] = descriptor_.velocityOverLife(age(i));
 
-            p.rotation += p.velocity * deltaTime;
-            p.position += p.velocity * deltaTime;
+            integrate(pool_, begin, end, deltaTime, scale);
         }
+
+        if(colliders_)
+            collide(pool_, begin, end, *colliders_);
     }
 
     void ParticleEmitter::render(Context &context, std::shared_ptr<Program> program, std::shared_ptr<VertexArray> vertexArray, GLint topology) noexcept
     {
-        for(const auto& p : pool_) {
-            if(!p.alive)
-                continue;
+        /**** resolved once per call, per particle uploads are plain table lookups ****/
+        const auto model = program->uniform<glm::mat4>("uModelMatrix");
+        const auto tint  = program->uniform<glm::vec4>("uMaterial.color");
 
-            auto life = p.remain / p.life;
+        program->bind();
 
-            auto size  = glm::lerp(p.size[1],  p.size[0],  life);
-            auto color = glm::lerp(p.color[1], p.color[0], life);
+        forEach([&](size_t i) {
+            const auto t = age(i);
 
-            auto transform = glm::translate(glm::mat4{1.0f}, p.position) *
-                             glm::rotate(glm::mat4{1.0f}, p.rotation.x, {1.0f, 0.0f, 0.0f}) *
-                             glm::rotate(glm::mat4{1.0f}, p.rotation.y, {0.0f, 1.0f, 0.0f}) *
-                             glm::rotate(glm::mat4{1.0f}, p.rotation.z, {0.0f, 0.0f, 1.0f}) *
+            auto size  = descriptor_.sizeOverLife(t);
+            auto color = descriptor_.colorOverLife(t);
+
+            auto transform = glm::translate(glm::mat4{1.0f}, {pool_.positionX[i], pool_.positionY[i], pool_.positionZ[i]}) *
+                             glm::rotate(glm::mat4{1.0f}, pool_.rotationX[i], {1.0f, 0.0f, 0.0f}) *
+                             glm::rotate(glm::mat4{1.0f}, pool_.rotationY[i], {0.0f, 1.0f, 0.0f}) *
+                             glm::rotate(glm::mat4{1.0f}, pool_.rotationZ[i], {0.0f, 0.0f, 1.0f}) *
                              glm::scale(glm::mat4{1.0f}, {size, size, size});
 
-            program->bind();
-            program->setUniform("uModelMatrix", transform);
-            program->setUniform("uMaterial.color", color);
+            program->setUniform(model, transform);
+            program->setUniform(tint,  color);
+
+            context.renderIndexed(vertexArray->indexCount(), vertexArray->indexType(), topology);
+        });
+    }
+
+    void ParticleEmitter::attachInstanceBuffer(VertexArray &vertexArray) noexcept
+    {
+        static_assert(sizeof (ParticleInstance) == 11 * sizeof (float), "ParticleInstance must be tightly packed.");
+
+        VertexLayout layout;
+        layout.push(AttributeType::Vector4f, "iPosition");
+        layout.push(AttributeType::Vector3f, "iRotation");
+        layout.push(AttributeType::Vector4f, "iColor");
+
+        auto buffer = std::make_unique<VertexBuffer>(layout, pool_.capacity(), BufferUsage::Dynamic);
+
+        instanceBuffer_  = buffer.get();
+        instanceBinding_ = vertexArray.vertexBufferCount();
+
+        vertexArray.append(std::move(buffer), 1u);
+    }
+
+    void ParticleEmitter::renderInstanced(Context &context, std::shared_ptr<Program> program, std::shared_ptr<VertexArray> vertexArray, GLint topology) noexcept
+    {
+        if(!instanceBuffer_) {
+            Log::e(TAG, "Instance buffer isn't attached.");
+            return;
+        }
+
+        instances_.clear();
+
+        forEach([&](size_t i) {
+            const auto t = age(i);
+
+            auto& instance = instances_.emplace_back();
+
+            instance.position = {pool_.positionX[i], pool_.positionY[i], pool_.positionZ[i], descriptor_.sizeOverLife(t)};
+            instance.rotation = {pool_.rotationX[i], pool_.rotationY[i], pool_.rotationZ[i]};
+            instance.color    = descriptor_.colorOverLife(t);
+        });
+
+        if(instances_.empty())
+            return;
 
-            context.renderIndexed(vertexArray->indexCount(), topology);
+        program->bind();
+
+        /**** stream through frame ring when available, own buffer otherwise ****/
+        auto transient = context.transient();
+
+        if(auto allocation = transient ? transient->push(instances_) : std::nullopt) {
+            vertexArray->rebind(instanceBinding_, transient->handler(), allocation->offset);
+        }
+        else {
+            instanceBuffer_->orphan(instances_.data(), instances_.size() * sizeof (ParticleInstance));
+
+            vertexArray->bind();
         }
+
+        context.renderIndexedInstanced(vertexArray->indexCount(), vertexArray->indexType(), instances_.size(), topology);
     }
 
-    void ParticleEmitter::spawn() noexcept
+    void ParticleEmitter::spawn(size_t count) noexcept
     {
-        auto& p = pool_[index];
+        sorted_ = false;
 
-        p.alive = true;
+        const auto taken = pool_.emplace(count);
+        const auto first = pool_.count() - taken;
+        const auto last  = pool_.count();
 
-        p.position = {0.0f, 0.0f, 0.0f};
+        auto scratch = scratch_.data();
 
-        p.velocity.x = random<float>(1.0f, 10.0f) * (random<float>(0.0f, 1.0f) - 0.5f);
-        p.velocity.y = random<float>(1.0f, 10.0f) * (random<float>(0.0f, 1.0f) - 0.5f);
-        p.velocity.z = random<float>(1.0f, 10.0f) * (random<float>(0.0f, 1.0f) - 0.5f);
+        /**** velocity and rotation: uniform(a, b) * (uniform(0, 1) - 0.5) per component ****/
+        auto component = [&](AlignedVector<float>& stream, float min, float max) noexcept {
+            auto out = stream.data() + first;
 
-        p.rotation.x = random<float>(2.5f, 2 * M_PI) * (random<float>(0.0f, 1.0f) - 0.5f);
-        p.rotation.y = random<float>(2.5f, 2 * M_PI) * (random<float>(0.0f, 1.0f) - 0.5f);
-        p.rotation.z = random<float>(2.5f, 2 * M_PI) * (random<float>(0.0f, 1.0f) - 0.5f);
+            random_.uniform(out,     taken, min,   max);
+            random_.uniform(scratch, taken, -0.5f, 0.5f);
 
-        p.size[1] = {0.0f};
-        p.size[0] = {1.0f};
+            for(size_t i = 0; i < taken; ++i)
+                out[i] *= scratch[i];
+        };
 
-        p.color[0] = {1.0f, 0.0f, 1.0f, 1.0f};
-        p.color[1] = {0.0f, 0.0f, 0.0f, 0.0f};
+        component(pool_.velocityX, descriptor_.velocity.x, descriptor_.velocity.y);
+        component(pool_.velocityY, descriptor_.velocity.x, descriptor_.velocity.y);
+        component(pool_.velocityZ, descriptor_.velocity.x, descriptor_.velocity.y);
 
-        p.life   = 8.0f;
-        p.remain = 8.0f;
+        component(pool_.rotationX, descriptor_.rotation.x, descriptor_.rotation.y);
+        component(pool_.rotationY, descriptor_.rotation.x, descriptor_.rotation.y);
+        component(pool_.rotationZ, descriptor_.rotation.x, descriptor_.rotation.y);
 
-        index = ++index % pool_.size();
+        std::fill(pool_.positionX.begin() + first, pool_.positionX.begin() + last, 0.0f);
+        std::fill(pool_.positionY.begin() + first, pool_.positionY.begin() + last, 0.0f);
+        std::fill(pool_.positionZ.begin() + first, pool_.positionZ.begin() + last, 0.0f);
+
+        std::fill(pool_.life.begin()   + first, pool_.life.begin()   + last, descriptor_.life);
+        std::fill(pool_.remain.begin() + first, pool_.remain.begin() + last, descriptor_.life);
+    }
+
+    void ParticleEmitter::sort(const glm::vec3 &viewPosition) noexcept
+    {
+        const auto count = pool_.count();
+
+        const auto px = pool_.positionX.data();
+        const auto py = pool_.positionY.data();
+        const auto pz = pool_.positionZ.data();
+
+        auto keys = scratch_.data();
+
+        /**** negative squared distance, ascending order is back to front ****/
+        for(size_t i = 0; i < count; ++i) {
+            const auto dx = px[i] - viewPosition.x;
+            const auto dy = py[i] - viewPosition.y;
+            const auto dz = pz[i] - viewPosition.z;
+
+            keys[i] = -(dx * dx + dy * dy + dz * dz);
+        }
+
+        order_  = &sorter_.sort(keys, count);
+        sorted_ = true;
+    }
+
+    void ParticleEmitter::setColliders(std::shared_ptr<const Colliders> colliders) noexcept
+    {
+        colliders_ = std::move(colliders);
+    }
+
+    ComputeParticleEmitter::ComputeParticleEmitter(const EmitterDescriptor &descriptor) :
+        descriptor_{descriptor}, capacity_{descriptor.capacity}, seed_{std::random_device()()}
+    {
+        if(!std::isfinite(descriptor_.life) || descriptor_.life <= 0.0f) {
+            Log::w(TAG, "Compute emitter requires positive life time, default is used.");
+
+            descriptor_.life = EmitterDescriptor{}.life;
+        }
+
+        if(descriptor_.curlNoise || descriptor_.fluid)
+            Log::w(TAG, "Compute emitter doesn't support curl noise or fluid, settings are ignored.");
+
+        program_ = std::make_shared<Program>();
+        program_->append(std::make_unique<Shader>(SIMULATION_CS, ShaderType::CS));
+
+        if(!program_->link())
+            Log::e(TAG, "Failed to link particle simulation program.");
+
+        deltaTimeUniform_   = program_->uniform<float>("uDeltaTime");
+        capacityUniform_    = program_->uniform<int>("uCapacity");
+        spawnOffsetUniform_ = program_->uniform<int>("uSpawnOffset");
+        spawnCountUniform_  = program_->uniform<int>("uSpawnCount");
+        seedUniform_        = program_->uniform<int>("uSeed");
+
+        /**** spawn ranges never change, uploaded once ****/
+        program_->setUniform(program_->uniform<glm::vec4>("uSpawnRange"), glm::vec4{descriptor_.velocity, descriptor_.rotation});
+        program_->setUniform(program_->uniform<float>("uLife"), descriptor_.life);
+
+        /**** 3 x vec4 per particle, zero rotation.w - dead ****/
+        const std::vector<glm::vec4> particles(capacity_ * 3u, glm::vec4{0.0f});
+
+        /**** DrawElementsIndirectCommand ****/
+        const std::array<uint32_t, 5> command {0u, 0u, 0u, 0u, 0u};
+
+        particles_ = std::make_unique<ShaderStorageBuffer>(particles.size() * sizeof (glm::vec4), particles.data(), BufferUsage::Dynamic);
+        alive_     = std::make_unique<ShaderStorageBuffer>(capacity_ * sizeof (uint32_t), nullptr, BufferUsage::Dynamic);
+        command_   = std::make_unique<ShaderStorageBuffer>(sizeof (command), command.data(), BufferUsage::Dynamic);
+
+        constexpr auto resolution = Curve<float>::RESOLUTION;
+
+        struct {
+            std::array<glm::vec4, resolution> color;
+            std::array<float,     resolution> size;
+            std::array<float,     resolution> velocity;
+        } curves;
+
+        curves.color    = descriptor_.colorOverLife.table();
+        curves.size     = descriptor_.sizeOverLife.table();
+        curves.velocity = descriptor_.velocityOverLife.table();
+
+        static_assert(sizeof (curves) == resolution * 6u * sizeof (float), "Curves must match std430 layout.");
+
+        curves_ = std::make_unique<ShaderStorageBuffer>(sizeof (curves), &curves, BufferUsage::Static);
+    }
+
+    ComputeParticleEmitter::~ComputeParticleEmitter()
+    {
+
+    }
+
+    void ComputeParticleEmitter::spawn(size_t count) noexcept
+    {
+        spawnCount_ = std::min(spawnCount_ + count, capacity_);
+    }
+
+    void ComputeParticleEmitter::update(Context &context, float deltaTime) noexcept
+    {
+        if(capacity_ == 0u)
+            return;
+
+        if(descriptor_.spawnRate > 0.0f) {
+            spawnDebt_ += descriptor_.spawnRate * deltaTime;
+
+            const auto count = static_cast<size_t>(spawnDebt_);
+
+            spawnDebt_ -= static_cast<float>(count);
+
+            spawn(count);
+        }
+
+        /**** reset instanceCount ****/
+        command_->clear(sizeof (uint32_t), sizeof (uint32_t));
+
+        program_->bind();
+        program_->setUniform(deltaTimeUniform_,   deltaTime);
+        program_->setUniform(capacityUniform_,    static_cast<int>(capacity_));
+        program_->setUniform(spawnOffsetUniform_, static_cast<int>(spawnOffset_));
+        program_->setUniform(spawnCountUniform_,  static_cast<int>(spawnCount_));
+        program_->setUniform(seedUniform_,        static_cast<int>(seed_++));
+
+        particles_->bindBase(0u);
+        alive_->bindBase(1u);
+        command_->bindBase(2u);
+        curves_->bindBase(3u);
+
+        context.dispatch(Context::workGroups(capacity_, WORK_GROUP_SIZE));
+        context.memoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+        spawnOffset_ = (spawnOffset_ + spawnCount_) % capacity_;
+        spawnCount_  = 0u;
+    }
+
+    void ComputeParticleEmitter::render(Context &context, std::shared_ptr<Program> program, std::shared_ptr<VertexArray> vertexArray, GLint topology) noexcept
+    {
+        const auto count = static_cast<uint32_t>(vertexArray->indexCount());
+
+        command_->update(&count, sizeof (count));
+
+        program->bind();
+
+        particles_->bindBase(0u);
+        alive_->bindBase(1u);
+        curves_->bindBase(2u);
+        command_->bindIndirect();
+
+        vertexArray->bind();
+
+        context.renderIndexedIndirect(vertexArray->indexType(), 0u, topology);
+    }
+
+    size_t ComputeParticleEmitter::capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    AnalyticParticleEmitter::AnalyticParticleEmitter(const EmitterDescriptor &descriptor) :
+        AnalyticParticleEmitter{descriptor, (static_cast<uint64_t>(std::random_device()()) << 32) | std::random_device()()}
+    {
+
+    }
+
+    AnalyticParticleEmitter::AnalyticParticleEmitter(const EmitterDescriptor &descriptor, uint64_t seed) :
+        descriptor_{descriptor}, random_{seed}
+    {
+        /**** emitter without records stays disabled, every other member treats zero count as no-op ****/
+        if(descriptor_.capacity == 0u || !std::isfinite(descriptor_.life) || descriptor_.life <= 0.0f) {
+            Log::e(TAG, "Analytic emitter requires capacity and positive life time, emitter is disabled.");
+            return;
+        }
+
+        if(!(descriptor_.spawnRate > 0.0f)) {
+            Log::w(TAG, "Analytic emitter requires spawn rate, whole pool is emitted over one life time.");
+
+            descriptor_.spawnRate = static_cast<float>(descriptor_.capacity) / descriptor_.life;
+        }
+
+        if(!std::isfinite(descriptor_.spawnRate)) {
+            Log::e(TAG, "Analytic emitter spawn rate is not finite, emitter is disabled.");
+            return;
+        }
+
+        if(descriptor_.curlNoise)
+            Log::w(TAG, "Analytic emitter doesn't support curl noise, field is ignored.");
+
+        if(descriptor_.fluid)
+            Log::w(TAG, "Analytic emitter doesn't support fluid, particles don't interact.");
+
+        /**** records beyond one life time would only ever be drawn dead ****/
+        const auto needed = std::ceil(static_cast<double>(descriptor_.spawnRate) * static_cast<double>(descriptor_.life));
+
+        if(static_cast<double>(descriptor_.capacity) < needed)
+            Log::w(TAG, "Analytic emitter capacity is too small for spawn rate, particles are cut before end of life.");
+
+        count_  = std::max<size_t>(1u, needed < static_cast<double>(descriptor_.capacity) ? static_cast<size_t>(needed) : descriptor_.capacity);
+        period_ = static_cast<float>(count_) / descriptor_.spawnRate;
+
+        constexpr auto resolution = Curve<float>::RESOLUTION;
+
+        struct {
+            std::array<glm::vec4, resolution> color;
+            std::array<float,     resolution> size;
+            std::array<float,     resolution> distance;
+        } curves;
+
+        curves.color = descriptor_.colorOverLife.table();
+        curves.size  = descriptor_.sizeOverLife.table();
+
+        /**** trapezoid integral of velocity scale over normalized age ****/
+        const auto& velocity = descriptor_.velocityOverLife.table();
+
+        curves.distance[0] = 0.0f;
+
+        for(size_t i = 1; i < resolution; ++i)
+            curves.distance[i] = curves.distance[i - 1] + 0.5f * (velocity[i - 1] + velocity[i]) / static_cast<float>(resolution - 1u);
+
+        static_assert(sizeof (curves) == resolution * 6u * sizeof (float), "Curves must match std430 layout.");
+
+        curves_ = std::make_unique<ShaderStorageBuffer>(sizeof (curves), &curves, BufferUsage::Static);
+    }
+
+    AnalyticParticleEmitter::~AnalyticParticleEmitter()
+    {
+
+    }
+
+    void AnalyticParticleEmitter::attachSpawnBuffer(VertexArray &vertexArray) noexcept
+    {
+        struct Record {
+            glm::vec4 velocity; // xyz - velocity, w - spawn time
+            glm::vec3 rotation;
+        };
+
+        const auto count = count_;
+
+        if(count == 0u)
+            return;
+
+        std::vector<Record> records(count);
+
+        AlignedVector<float> a(count);
+        AlignedVector<float> b(count);
+
+        auto component = [&](float min, float max, auto&& assign) noexcept {
+            random_.uniform(a.data(), count, min,   max);
+            random_.uniform(b.data(), count, -0.5f, 0.5f);
+
+            for(size_t i = 0; i < count; ++i)
+                assign(records[i], a[i] * b[i]);
+        };
+
+        component(descriptor_.velocity.x, descriptor_.velocity.y, [](Record& r, float v) { r.velocity.x = v; });
+        component(descriptor_.velocity.x, descriptor_.velocity.y, [](Record& r, float v) { r.velocity.y = v; });
+        component(descriptor_.velocity.x, descriptor_.velocity.y, [](Record& r, float v) { r.velocity.z = v; });
+
+        component(descriptor_.rotation.x, descriptor_.rotation.y, [](Record& r, float v) { r.rotation.x = v; });
+        component(descriptor_.rotation.x, descriptor_.rotation.y, [](Record& r, float v) { r.rotation.y = v; });
+        component(descriptor_.rotation.x, descriptor_.rotation.y, [](Record& r, float v) { r.rotation.z = v; });
+
+        for(size_t i = 0; i < count; ++i)
+            records[i].velocity.w = static_cast<float>(i) / descriptor_.spawnRate;
+
+        VertexLayout layout;
+        layout.push(AttributeType::Vector4f, "iVelocity");
+        layout.push(AttributeType::Vector3f, "iRotation");
+
+        auto buffer = std::make_unique<VertexBuffer>(layout, count, BufferUsage::Static);
+
+        buffer->update(records.data(), records.size() * sizeof (Record));
+
+        vertexArray.append(std::move(buffer), 1u);
+    }
+
+    void AnalyticParticleEmitter::attachProgram(std::shared_ptr<Program> program) noexcept
+    {
+        program_ = std::move(program);
+
+        timeUniform_   = program_->uniform<float>("uTime");
+        periodUniform_ = program_->uniform<float>("uPeriod");
+        lifeUniform_   = program_->uniform<float>("uLife");
+
+        program_->setUniform(lifeUniform_, descriptor_.life);
+    }
+
+    void AnalyticParticleEmitter::update(float deltaTime) noexcept
+    {
+        if(count_ == 0u)
+            return;
+
+        time_ += deltaTime;
+
+        /**** keep clock in [period, 2 * period) once every record was spawned, preserves float precision ****/
+        if(time_ >= 2.0 * period_)
+            time_ = period_ + std::fmod(time_ - period_, static_cast<double>(period_));
+    }
+
+    void AnalyticParticleEmitter::render(Context &context, std::shared_ptr<VertexArray> vertexArray, GLint topology) noexcept
+    {
+        if(count_ == 0u || !program_)
+            return;
+
+        program_->bind();
+        program_->setUniform(timeUniform_,   static_cast<float>(time_));
+        program_->setUniform(periodUniform_, period_);
+
+        curves_->bindBase(0u);
+
+        vertexArray->bind();
+
+        context.renderIndexedInstanced(vertexArray->indexCount(), vertexArray->indexType(), count_, topology);
+    }
+
+    size_t AnalyticParticleEmitter::count() const noexcept
+    {
+        return count_;
     }
 
 }
@@ -1,36 +1,179 @@
 #pragma once
 
+#include "Sort.hpp"
+#include "Curve.hpp"
+#include "Fluid.hpp"
+#include "ForceField.hpp"
+#include "Random.hpp"
+#include "Aligned.hpp"
+#include "Program.hpp"
+
 #include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
 
 #include <array>
 #include <memory>
+#include <vector>
+#include <optional>
 
 #include <glad/glad.h>
 
 namespace glem {
 
     class Context;
-    class Program;
     class VertexArray;
+    class VertexBuffer;
+    class ThreadPool;
+    class ShaderStorageBuffer;
 
-    struct Particle {
-        glm::vec3 position {glm::vec3{0.0f}};
-        glm::vec3 velocity {glm::vec3{0.0f}};
-        glm::vec3 rotation {glm::vec3{0.0f}};
+    struct Colliders;
+
+    /**
+     * @brief Structure-of-arrays particle storage
+     *
+     * Every stream is 32-byte aligned and padded to multiple of 8 elements,
+     * so integration kernel runs on full SIMD registers. Alive particles are
+     * kept dense in range [0, count()), the tail [count(), capacity()) is free.
+     */
+    class ParticlePool {
+    public:
+        ParticlePool(size_t capacity);
+        ~ParticlePool() = default;
+
+        /**
+         * @brief Pool capacity
+         * @return
+         */
+        size_t capacity() const noexcept;
+
+        /**
+         * @brief Number of alive particles
+         * @return
+         */
+        size_t count() const noexcept;
+
+        /**
+         * @brief Take first free slot
+         * @return Slot index or nothing if pool is full
+         */
+        std::optional<size_t> emplace() noexcept;
+
+        /**
+         * @brief Take up to count free slots, taken slots are [count() - taken, count())
+         * @param count
+         * @return Number of taken slots
+         */
+        size_t emplace(size_t count) noexcept;
+
+        /**
+         * @brief Kill particle, last alive particle is moved into its slot
+         * @param index
+         */
+        void kill(size_t index) noexcept;
+
+        /**
+         * @brief Kill all expired particles (remain <= 0)
+         */
+        void compact() noexcept;
+
+        AlignedVector<float> positionX;
+        AlignedVector<float> positionY;
+        AlignedVector<float> positionZ;
+
+        AlignedVector<float> velocityX;
+        AlignedVector<float> velocityY;
+        AlignedVector<float> velocityZ;
+
+        AlignedVector<float> rotationX;
+        AlignedVector<float> rotationY;
+        AlignedVector<float> rotationZ;
+
+        AlignedVector<float> life;
+        AlignedVector<float> remain;
+
+    private:
+        size_t capacity_ {0u};
+        size_t count_    {0u};
+
+    };
+
+    /**
+     * @brief Integrate particles in range [begin, end): position and rotation by velocity, remaining life by delta time
+     * @param pool
+     * @param begin
+     * @param end
+     * @param deltaTime
+     * @param velocityScale - optional per particle velocity multiplier, indexed as pool streams
+     */
+    void integrate(ParticlePool& pool, size_t begin, size_t end, float deltaTime, const float* velocityScale = nullptr) noexcept;
+
+    /**
+     * @brief Emitter settings, curves are evaluated over normalized particle age [0, 1]
+     */
+    struct EmitterDescriptor {
+        size_t capacity {10000u};
+
+        /**
+         * @brief Particles spawned per second by update, 0 - spawn() only
+         */
+        float spawnRate {0.0f};
+
+        /**
+         * @brief Life time in seconds
+         */
+        float life {8.0f};
+
+        /**
+         * @brief Spawn velocity per axis: uniform(min, max) * uniform(-0.5, 0.5)
+         */
+        glm::vec2 velocity {1.0f, 10.0f};
 
-        std::array<float, 2> size;
+        /**
+         * @brief Spawn rotation per axis: uniform(min, max) * uniform(-0.5, 0.5)
+         */
+        glm::vec2 rotation {2.5f, glm::two_pi<float>()};
+
+        Curve<float> sizeOverLife {
+            {0.0f, 1.0f},
+            {1.0f, 0.0f}
+        };
 
-        std::array<glm::vec4, 2> color;
+        Curve<glm::vec4> colorOverLife {
+            {0.0f, glm::vec4{1.0f, 0.0f, 1.0f, 1.0f}},
+            {1.0f, glm::vec4{0.0f, 0.0f, 0.0f, 0.0f}}
+        };
 
-        float life   {0.0f};
-        float remain {0.0f};
+        Curve<float> velocityOverLife {1.0f};
+
+        /**
+         * @brief Particles per task of parallel update, rounded up to multiple of 8
+         */
+        size_t chunkSize {16384u};
 
-        bool alive {false};
+        /**
+         * @brief Run SPH step before integration, particles interact as fluid
+         */
+        std::optional<FluidDescriptor> fluid;
+
+        /**
+         * @brief Accelerate particles by curl noise flow before integration
+         */
+        std::optional<CurlNoiseField> curlNoise;
+    };
+
+    /**
+     * @brief Per-instance particle data consumed by instanced particle program
+     */
+    struct ParticleInstance {
+        glm::vec4 position {glm::vec4{0.0f}}; // xyz - position, w - size
+        glm::vec3 rotation {glm::vec3{0.0f}};
+        glm::vec4 color    {glm::vec4{0.0f}};
     };
 
     class ParticleEmitter {
     public:
-        ParticleEmitter();
+        ParticleEmitter(const EmitterDescriptor& descriptor = EmitterDescriptor{});
+        ParticleEmitter(const EmitterDescriptor& descriptor, uint64_t seed);
         ~ParticleEmitter();
 
         ParticleEmitter(ParticleEmitter&&) = delete;
@@ -40,11 +183,26 @@ namespace glem {
         ParticleEmitter& operator=(const ParticleEmitter&) = delete;
 
         /**
-         * @brief Update
+         * @brief Update: kill expired particles, spawn by descriptor rate, apply fluid forces, integrate alive ones
          * @param deltaTime
          */
         void update(float deltaTime) noexcept;
 
+        /**
+         * @brief Update with integration split into descriptor chunks across thread pool
+         * @param deltaTime
+         * @param threads
+         */
+        void update(float deltaTime, ThreadPool& threads) noexcept;
+
+        /**
+         * @brief Update independent emitters concurrently, one task per emitter
+         * @param emitters
+         * @param deltaTime
+         * @param threads
+         */
+        static void update(const std::vector<ParticleEmitter*>& emitters, float deltaTime, ThreadPool& threads) noexcept;
+
         /**
          * @brief Render
          * @param context
@@ -52,12 +210,269 @@ namespace glem {
         void render(Context& context, std::shared_ptr<Program> program, std::shared_ptr<VertexArray> vertexArray, GLint topology = GL_TRIANGLES) noexcept;
 
         /**
-         * @brief Spawn
+         * @brief Create per-instance buffer and append it to particle mesh vertex array
+         * @param vertexArray - particle mesh, instance attributes are appended after mesh attributes
+         */
+        void attachInstanceBuffer(VertexArray& vertexArray) noexcept;
+
+        /**
+         * @brief Render all alive particles with single instanced draw call
+         * @param context
+         * @param program     - instanced particle program
+         * @param vertexArray - particle mesh with attached instance buffer
+         * @param topology
+         */
+        void renderInstanced(Context& context, std::shared_ptr<Program> program, std::shared_ptr<VertexArray> vertexArray, GLint topology = GL_TRIANGLES) noexcept;
+
+        /**
+         * @brief Spawn particles in one batch, spawns are dropped when pool is full
+         * @param count
+         */
+        void spawn(size_t count = 1u) noexcept;
+
+        /**
+         * @brief Sort alive particles back to front, order is used by render calls until next update or spawn
+         * @param viewPosition - camera position
          */
-        void spawn() noexcept;
+        void sort(const glm::vec3& viewPosition) noexcept;
+
+        /**
+         * @brief Set colliders resolved after integration on every update, nullptr disables collision stage
+         * @param colliders - may be shared between emitters
+         */
+        void setColliders(std::shared_ptr<const Colliders> colliders) noexcept;
 
     private:
-        std::array<Particle, 10000> pool_;
+        /**
+         * @brief Kill expired particles and spawn by rate, serial part of update
+         */
+        void prepare(float deltaTime) noexcept;
+
+        /**
+         * @brief Apply force field, integrate and collide particles in range [begin, end), safe to run on disjoint ranges concurrently
+         */
+        void advance(size_t begin, size_t end, float deltaTime) noexcept;
+
+        template<typename Function>
+        void forEach(Function&& function) const noexcept {
+            if(sorted_) {
+                for(auto i : *order_)
+                    function(static_cast<size_t>(i));
+            }
+            else {
+                for(size_t i = 0; i < pool_.count(); ++i)
+                    function(i);
+            }
+        }
+
+        /**
+         * @brief Normalized age of particle
+         */
+        inline float age(size_t index) const noexcept {
+            return 1.0f - pool_.remain[index] / pool_.life[index];
+        }
+
+        EmitterDescriptor descriptor_;
+
+        ParticlePool pool_;
+
+        Random random_;
+
+        float spawnDebt_ {0.0f};
+
+        float time_ {0.0f};
+
+        bool constantVelocity_ {true};
+
+        AlignedVector<float> scratch_;
+
+        RadixSort sorter_;
+
+        const std::vector<uint32_t>* order_ {nullptr};
+
+        bool sorted_ {false};
+
+        std::vector<ParticleInstance> instances_;
+
+        VertexBuffer* instanceBuffer_ {nullptr};
+
+        size_t instanceBinding_ {0u};
+
+        std::shared_ptr<const Colliders> colliders_ {nullptr};
+
+        std::unique_ptr<SphSolver> fluid_ {nullptr};
+
+    };
+
+    /**
+     * @brief Particle emitter simulated entirely on GPU
+     *
+     * Particle state lives in shader storage buffers, compute shader spawns,
+     * integrates and kills particles and appends alive ones to draw indirect
+     * command, so rendering never round-trips through CPU. Spawn ranges, life and
+     * curves come from descriptor, curl noise, fluid and colliders are not supported.
+     * Render program reads std430 particles from binding 0 and alive indices from
+     * binding 1 by gl_InstanceID, and curves over normalized age from binding 2:
+     *
+     * struct Particle {
+     *     vec4 position; // xyz - position, w - remaining life
+     *     vec4 velocity; // xyz - velocity, w - life
+     *     vec4 rotation; // xyz - rotation, w - alive flag
+     * };
+     *
+     * buffer Curves {
+     *     vec4  color[64];
+     *     float size[64];
+     *     float velocityScale[64];
+     * };
+     */
+    class ComputeParticleEmitter {
+    public:
+        ComputeParticleEmitter(const EmitterDescriptor& descriptor = EmitterDescriptor{});
+        ~ComputeParticleEmitter();
+
+        ComputeParticleEmitter(ComputeParticleEmitter&&) = delete;
+        ComputeParticleEmitter(const ComputeParticleEmitter&) = delete;
+
+        ComputeParticleEmitter& operator=(ComputeParticleEmitter&&) = delete;
+        ComputeParticleEmitter& operator=(const ComputeParticleEmitter&) = delete;
+
+        /**
+         * @brief Queue particles to spawn on next update, oldest slots are reused round-robin
+         * @param count
+         */
+        void spawn(size_t count = 1u) noexcept;
+
+        /**
+         * @brief Spawn queued particles, integrate and kill expired ones on GPU
+         * @param context
+         * @param deltaTime
+         */
+        void update(Context& context, float deltaTime) noexcept;
+
+        /**
+         * @brief Render alive particles with single indirect draw call
+         * @param context
+         * @param program     - particle program reading storage buffers
+         * @param vertexArray - particle mesh
+         * @param topology
+         */
+        void render(Context& context, std::shared_ptr<Program> program, std::shared_ptr<VertexArray> vertexArray, GLint topology = GL_TRIANGLES) noexcept;
+
+        /**
+         * @brief Pool capacity
+         * @return
+         */
+        size_t capacity() const noexcept;
+
+    private:
+        EmitterDescriptor descriptor_;
+
+        size_t capacity_    {0u};
+        size_t spawnOffset_ {0u};
+        size_t spawnCount_  {0u};
+
+        float spawnDebt_ {0.0f};
+
+        uint32_t seed_ {0u};
+
+        std::shared_ptr<Program> program_ {nullptr};
+
+        UniformHandle<float> deltaTimeUniform_;
+        UniformHandle<int>   capacityUniform_;
+        UniformHandle<int>   spawnOffsetUniform_;
+        UniformHandle<int>   spawnCountUniform_;
+        UniformHandle<int>   seedUniform_;
+
+        std::unique_ptr<ShaderStorageBuffer> particles_ {nullptr};
+        std::unique_ptr<ShaderStorageBuffer> alive_     {nullptr};
+        std::unique_ptr<ShaderStorageBuffer> command_   {nullptr};
+        std::unique_ptr<ShaderStorageBuffer> curves_    {nullptr};
+
+    };
+
+    /**
+     * @brief Stateless particle emitter evaluated in closed form by vertex shader
+     *
+     * Spawn records (velocity, spawn time, rotation) are uploaded once, one life time
+     * worth of them, ceil(spawnRate * life) bounded by capacity, and emission repeats
+     * every records / spawnRate seconds. Curl noise, fluid and colliders need particle
+     * state, so they are not supported. Vertex shader derives position,
+     * rotation, size and color from record and emitter time, per frame CPU cost
+     * is one uniform and one draw call. Render program takes records as instance
+     * attributes and curves from std430 binding 0:
+     *
+     * layout(location = N)     in vec4 iVelocity; // xyz - velocity, w - spawn time
+     * layout(location = N + 1) in vec3 iRotation;
+     *
+     * buffer Curves {
+     *     vec4  color[64];
+     *     float size[64];
+     *     float distance[64]; // integral of velocity curve over normalized age
+     * };
+     */
+    class AnalyticParticleEmitter {
+    public:
+        AnalyticParticleEmitter(const EmitterDescriptor& descriptor = EmitterDescriptor{});
+        AnalyticParticleEmitter(const EmitterDescriptor& descriptor, uint64_t seed);
+        ~AnalyticParticleEmitter();
+
+        AnalyticParticleEmitter(AnalyticParticleEmitter&&) = delete;
+        AnalyticParticleEmitter(const AnalyticParticleEmitter&) = delete;
+
+        AnalyticParticleEmitter& operator=(AnalyticParticleEmitter&&) = delete;
+        AnalyticParticleEmitter& operator=(const AnalyticParticleEmitter&) = delete;
+
+        /**
+         * @brief Generate spawn records and append them to particle mesh vertex array as instance attributes
+         * @param vertexArray
+         */
+        void attachSpawnBuffer(VertexArray& vertexArray) noexcept;
+
+        /**
+         * @brief Set render program and resolve its uniforms
+         * @param program - linked analytic particle program
+         */
+        void attachProgram(std::shared_ptr<Program> program) noexcept;
+
+        /**
+         * @brief Advance emitter clock
+         * @param deltaTime
+         */
+        void update(float deltaTime) noexcept;
+
+        /**
+         * @brief Render all particles with single instanced draw call of attached program
+         * @param context
+         * @param vertexArray - particle mesh with attached spawn buffer
+         * @param topology
+         */
+        void render(Context& context, std::shared_ptr<VertexArray> vertexArray, GLint topology = GL_TRIANGLES) noexcept;
+
+        /**
+         * @brief Number of spawn records, also instance count of draw
+         * @return Zero if descriptor was rejected, emitter then neither updates nor renders
+         */
+        size_t count() const noexcept;
+
+    private:
+        EmitterDescriptor descriptor_;
+
+        Random random_;
+
+        double time_ {0.0};
+
+        float period_ {0.0f};
+
+        size_t count_ {0u};
+
+        std::shared_ptr<Program> program_ {nullptr};
+
+        UniformHandle<float> timeUniform_;
+        UniformHandle<float> periodUniform_;
+        UniformHandle<float> lifeUniform_;
+
+        std::unique_ptr<ShaderStorageBuffer> curves_ {nullptr};
 
     };
 
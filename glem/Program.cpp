@@ -1,6 +1,11 @@
 #include "Program.hpp"
 
 #include "Log.hpp"
+#include "ProgramCache.hpp"
+#include "ProgramLibrary.hpp"
+
+#include <cstring>
+#include <algorithm>
 
 #include <glm/gtc/type_ptr.hpp>
 
@@ -8,13 +13,70 @@
 
 namespace {
     const std::string TAG = "Program";
+
+    /**
+     * @brief GL_KHR_parallel_shader_compile completion query, same value in ARB variant
+     */
+    static constexpr const GLenum COMPLETION_STATUS = 0x91B1;
 }
 
 namespace glem {
 
+    template<> struct UniformTypeMap<int> {
+        static constexpr uint32_t type = GL_INT;
+    };
+
+    template<> struct UniformTypeMap<float> {
+        static constexpr uint32_t type = GL_FLOAT;
+    };
+
+    template<> struct UniformTypeMap<glm::vec3> {
+        static constexpr uint32_t type = GL_FLOAT_VEC3;
+    };
+
+    template<> struct UniformTypeMap<glm::vec4> {
+        static constexpr uint32_t type = GL_FLOAT_VEC4;
+    };
+
+    template<> struct UniformTypeMap<glm::mat4> {
+        static constexpr uint32_t type = GL_FLOAT_MAT4;
+    };
+
+    namespace {
+        /**
+         * @brief Check if uniform declared as type accepts value of expected type
+         */
+        bool compatible(uint32_t type, uint32_t expected) noexcept {
+            if(type == expected)
+                return true;
+
+            if(expected != GL_INT)
+                return false;
+
+            switch (type) {
+            case GL_BOOL:
+            case GL_SAMPLER_1D:
+            case GL_SAMPLER_2D:
+            case GL_SAMPLER_3D:
+            case GL_SAMPLER_CUBE:
+            case GL_SAMPLER_2D_SHADOW:
+            case GL_SAMPLER_CUBE_SHADOW:
+            case GL_SAMPLER_2D_ARRAY:
+            case GL_SAMPLER_2D_ARRAY_SHADOW:
+            case GL_SAMPLER_2D_MULTISAMPLE:
+            case GL_SAMPLER_BUFFER:
+            case GL_INT_SAMPLER_2D:
+            case GL_UNSIGNED_INT_SAMPLER_2D:
+                return true;
+            default:
+                return false;
+            }
+        }
+    }
+
     Program::Program()
     {
-        handler_ = glCreateProgram();
+
     }
 
     Program::~Program()
@@ -34,20 +96,96 @@ namespace glem {
 
     void Program::append(std::unique_ptr<Shader> value) noexcept
     {
-        glAttachShader(handler_, value->handler());
+        stages_.push_back({value->type(), value->source()});
+
+        for(const auto& define : value->defines())
+            if(std::find(defines_.begin(), defines_.end(), define) == defines_.end())
+                defines_.push_back(define);
 
         shaders_.emplace_back(std::move(value));
     }
 
-    bool Program::link() const noexcept
+    std::shared_ptr<Program> Program::variant(const std::vector<std::string> &defines, ProgramBatch *batch) const noexcept
+    {
+        auto merged = defines_;
+
+        merged.insert(merged.end(), defines.begin(), defines.end());
+
+        return ProgramLibrary::instance().acquire(stages_, std::move(merged), batch);
+    }
+
+    bool Program::link() noexcept
     {
+        submit();
+
+        return finish();
+    }
+
+    void Program::submit() noexcept
+    {
+        if(status_ != ProgramStatus::Idle)
+            return;
+
+        /**** GL object is created on first submit, so templates used only for variants own none ****/
+        handler_ = glCreateProgram();
+
+        auto& cache = ProgramCache::instance();
+
+        cached_ = cache.enabled();
+        key_    = cached_ ? cache.key(shaders_) : ProgramCache::Key{};
+
+        if(cached_ && restore(key_)) {
+            shaders_.clear();
+            key_ = {};
+
+            reflect();
+
+            status_ = ProgramStatus::Linked;
+
+            return;
+        }
+
+        /**** issue every stage before first status query so driver may compile them concurrently ****/
+        for(const auto& shader : shaders_)
+            shader->submit();
+
+        for(const auto& shader : shaders_)
+            glAttachShader(handler_, shader->handler());
+
+        if(cached_)
+            glProgramParameteri(handler_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
         glLinkProgram(handler_);
 
+        status_ = ProgramStatus::Linking;
+    }
+
+    bool Program::ready() const noexcept
+    {
+        if(status_ != ProgramStatus::Linking || !Shader::parallelCompile())
+            return true;
+
+        int ret {GL_TRUE};
+
+        glGetProgramiv(handler_, COMPLETION_STATUS, &ret);
+
+        return ret == GL_TRUE;
+    }
+
+    bool Program::finish() noexcept
+    {
+        if(status_ != ProgramStatus::Linking)
+            return status_ == ProgramStatus::Linked;
+
         int ret {0};
 
         glGetProgramiv(handler_, GL_LINK_STATUS, &ret);
 
         if(ret == GL_FALSE) {
+            /**** stage logs are more useful than link log when compilation failed ****/
+            for(const auto& shader : shaders_)
+                shader->compile();
+
             int length {0};
 
             glGetProgramiv(handler_, GL_INFO_LOG_LENGTH, &length);
@@ -59,87 +197,326 @@ namespace glem {
             Log::e(TAG, "Unable to link program: ", msg);
 
             shaders_.clear();
+            key_ = {};
 
             glDeleteProgram(handler_);
 
+            handler_ = 0u;
+
+            status_ = ProgramStatus::Failed;
+
             return false;
         }
 
+        if(cached_)
+            save(key_);
+
         shaders_.clear();
+        key_ = {};
+
+        reflect();
+
+        status_ = ProgramStatus::Linked;
 
         return true;
     }
 
-    bool Program::setUniform(const std::string &tag, int value) noexcept
+    ProgramStatus Program::status() const noexcept
     {
-        if(auto location = resolveUniformLocation(tag)) {
-            glUniform1i(*location, value);
-            return true;
+        return status_;
+    }
+
+    glm::uvec3 Program::workGroupSize() const noexcept
+    {
+        return workGroupSize_;
+    }
+
+    bool Program::restore(const ProgramCache::Key& key) noexcept
+    {
+        auto& cache = ProgramCache::instance();
+
+        const auto binary = cache.load(key);
+
+        if(!binary)
+            return false;
+
+        int count {0};
+
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count);
+
+        std::vector<int> formats(static_cast<size_t>(count));
+
+        glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats.data());
+
+        if(std::find(formats.begin(), formats.end(), static_cast<int>(binary->format)) == formats.end()) {
+            cache.remove(key);
+            return false;
         }
 
-        Log::e(TAG, "Failed to resolve uniform location: ", tag);
+        glProgramBinary(handler_, binary->format, binary->data.data(), static_cast<GLsizei>(binary->data.size()));
+
+        int ret {GL_FALSE};
+
+        glGetProgramiv(handler_, GL_LINK_STATUS, &ret);
+
+        if(ret == GL_FALSE) {
+            /**** driver or its settings changed in a way key can't see, relink from source ****/
+            Log::d(TAG, "Program binary rejected, linking from source.");
 
-        return false;
+            cache.remove(key);
+
+            return false;
+        }
+
+        return true;
     }
 
-    bool Program::setUniform(const std::string &tag, float value) noexcept
+    void Program::save(const ProgramCache::Key& key) const noexcept
     {
-        if(auto location = resolveUniformLocation(tag)) {
-            glUniform1f(*location, value);
-            return true;
-        }
+        int length {0};
 
-        Log::e(TAG, "Failed to resolve uniform location: ", tag);
+        glGetProgramiv(handler_, GL_PROGRAM_BINARY_LENGTH, &length);
+
+        if(length <= 0)
+            return;
+
+        ProgramCache::Binary binary;
+
+        binary.data.resize(static_cast<size_t>(length));
+
+        GLenum format {0u};
+
+        glGetProgramBinary(handler_, length, &length, &format, binary.data.data());
+
+        binary.data.resize(static_cast<size_t>(length));
+        binary.format = format;
 
-        return false;
+        ProgramCache::instance().store(key, binary);
     }
 
-    bool Program::setUniform(const std::string &tag, const glm::vec3 &value) noexcept
+    template<typename T>
+    UniformHandle<T> Program::uniform(const std::string &tag) const noexcept
     {
-        if(auto location = resolveUniformLocation(tag)) {
-            glUniform3f(*location, value.x, value.y, value.z);
-            return true;
+        if(auto it = indices_.find(tag); it != indices_.end()) {
+            if(compatible(uniforms_[it->second].type, UniformTypeMap<T>::type))
+                return {it->second};
+
+            Log::e(TAG, "Uniform type mismatch: ", tag);
+
+            return {};
         }
 
         Log::e(TAG, "Failed to resolve uniform location: ", tag);
 
-        return false;
+        return {};
     }
 
-    bool Program::setUniform(const std::string &tag, const glm::vec4 &value) noexcept
+    template UniformHandle<int>       Program::uniform<int>(const std::string&) const noexcept;
+    template UniformHandle<float>     Program::uniform<float>(const std::string&) const noexcept;
+    template UniformHandle<glm::vec3> Program::uniform<glm::vec3>(const std::string&) const noexcept;
+    template UniformHandle<glm::vec4> Program::uniform<glm::vec4>(const std::string&) const noexcept;
+    template UniformHandle<glm::mat4> Program::uniform<glm::mat4>(const std::string&) const noexcept;
+
+    template<typename T>
+    Program::Uniform *Program::resolve(UniformHandle<T> handle) noexcept
     {
-        if(auto location = resolveUniformLocation(tag)) {
-            glUniform4f(*location, value.x, value.y, value.z, value.w);
-            return true;
-        }
+        if(status_ != ProgramStatus::Linked || !handle || static_cast<size_t>(handle.index) >= uniforms_.size())
+            return nullptr;
 
-        Log::e(TAG, "Failed to resolve uniform location: ", tag);
+        auto& uniform = uniforms_[static_cast<size_t>(handle.index)];
+
+        if(!compatible(uniform.type, UniformTypeMap<T>::type))
+            return nullptr;
 
-        return false;
+        return &uniform;
     }
 
-    bool Program::setUniform(const std::string &tag, const glm::mat4 &value) noexcept
+    template<typename T>
+    bool Program::changed(Uniform &uniform, const T &value) noexcept
     {
-        if(auto location = resolveUniformLocation(tag)) {
-            glUniformMatrix4fv(*location, 1, GL_FALSE, glm::value_ptr(value));
-            return true;
+        static_assert(sizeof (T) <= sizeof (Uniform::shadow), "Uniform value doesn't fit shadow copy.");
+
+        if(uniform.cached && std::memcmp(uniform.shadow.data(), &value, sizeof (T)) == 0) {
+            ++statistics_.skipped;
+            return false;
         }
 
-        Log::e(TAG, "Failed to resolve uniform location: ", tag);
+        std::memcpy(uniform.shadow.data(), &value, sizeof (T));
 
-        return false;
+        uniform.cached = true;
+
+        ++statistics_.issued;
+
+        return true;
     }
 
-    std::optional<int> Program::resolveUniformLocation(const std::string &value) noexcept {
-        if(auto it = location.find(value); it != location.end())
-            return location[value];
+    bool Program::setUniform(UniformHandle<int> handle, int value) noexcept
+    {
+        auto uniform = resolve(handle);
+
+        if(!uniform)
+            return false;
+
+        if(changed(*uniform, value))
+            glProgramUniform1i(handler_, uniform->location, value);
+
+        return true;
+    }
+
+    bool Program::setUniform(UniformHandle<float> handle, float value) noexcept
+    {
+        auto uniform = resolve(handle);
+
+        if(!uniform)
+            return false;
+
+        if(changed(*uniform, value))
+            glProgramUniform1f(handler_, uniform->location, value);
+
+        return true;
+    }
+
+    bool Program::setUniform(UniformHandle<glm::vec3> handle, const glm::vec3 &value) noexcept
+    {
+        auto uniform = resolve(handle);
+
+        if(!uniform)
+            return false;
+
+        if(changed(*uniform, value))
+            glProgramUniform3f(handler_, uniform->location, value.x, value.y, value.z);
+
+        return true;
+    }
+
+    bool Program::setUniform(UniformHandle<glm::vec4> handle, const glm::vec4 &value) noexcept
+    {
+        auto uniform = resolve(handle);
+
+        if(!uniform)
+            return false;
+
+        if(changed(*uniform, value))
+            glProgramUniform4f(handler_, uniform->location, value.x, value.y, value.z, value.w);
+
+        return true;
+    }
+
+    bool Program::setUniform(UniformHandle<glm::mat4> handle, const glm::mat4 &value) noexcept
+    {
+        auto uniform = resolve(handle);
+
+        if(!uniform)
+            return false;
+
+        if(changed(*uniform, value))
+            glProgramUniformMatrix4fv(handler_, uniform->location, 1, GL_FALSE, glm::value_ptr(value));
+
+        return true;
+    }
+
+    const Program::Statistics &Program::statistics() const noexcept
+    {
+        return statistics_;
+    }
 
-        if(auto l = glGetUniformLocation(handler_, value.c_str()); l != -1) {
-            location[value] = l;
-            return l;
+    void Program::resetStatistics() noexcept
+    {
+        statistics_ = {};
+    }
+
+    bool Program::setUniform(const std::string &tag, int value) noexcept
+    {
+        return setUniform(uniform<int>(tag), value);
+    }
+
+    bool Program::setUniform(const std::string &tag, float value) noexcept
+    {
+        return setUniform(uniform<float>(tag), value);
+    }
+
+    bool Program::setUniform(const std::string &tag, const glm::vec3 &value) noexcept
+    {
+        return setUniform(uniform<glm::vec3>(tag), value);
+    }
+
+    bool Program::setUniform(const std::string &tag, const glm::vec4 &value) noexcept
+    {
+        return setUniform(uniform<glm::vec4>(tag), value);
+    }
+
+    bool Program::setUniform(const std::string &tag, const glm::mat4 &value) noexcept
+    {
+        return setUniform(uniform<glm::mat4>(tag), value);
+    }
+
+    void Program::reflect() noexcept
+    {
+        uniforms_.clear();
+        indices_.clear();
+
+        statistics_ = {};
+
+        /**** query is an error for programs without compute stage ****/
+        workGroupSize_ = glm::uvec3{0u};
+
+        const auto compute = std::any_of(stages_.begin(), stages_.end(), [](const auto& stage) {
+            return stage.type == ShaderType::CS;
+        });
+
+        if(compute) {
+            GLint size[3] {0, 0, 0};
+
+            glGetProgramiv(handler_, GL_COMPUTE_WORK_GROUP_SIZE, size);
+
+            workGroupSize_ = glm::uvec3{size[0], size[1], size[2]};
         }
 
-        return {};
+        int count {0};
+        int length {0};
+
+        glGetProgramInterfaceiv(handler_, GL_UNIFORM, GL_ACTIVE_RESOURCES, &count);
+        glGetProgramInterfaceiv(handler_, GL_UNIFORM, GL_MAX_NAME_LENGTH, &length);
+
+        static constexpr const GLenum properties[] = {GL_BLOCK_INDEX, GL_TYPE, GL_LOCATION, GL_ARRAY_SIZE};
+
+        std::string name(std::size_t(length), '\0');
+
+        for(int i = 0; i < count; ++i) {
+            int values[4] {0};
+
+            glGetProgramResourceiv(handler_, GL_UNIFORM, static_cast<GLuint>(i), 4, properties, 4, nullptr, values);
+
+            /**** uniform block members are set through buffers ****/
+            if(values[0] != -1 || values[2] == -1)
+                continue;
+
+            int size {0};
+
+            glGetProgramResourceName(handler_, GL_UNIFORM, static_cast<GLuint>(i), length, &size, name.data());
+
+            const auto index = static_cast<int32_t>(uniforms_.size());
+
+            auto& uniform = uniforms_.emplace_back(Uniform{name.substr(0, std::size_t(size)), static_cast<uint32_t>(values[1]), values[2]});
+
+            indices_.emplace(uniform.name, index);
+
+            /**** arrays are reported as name[0], every element gets own entry ****/
+            if(const auto bracket = uniform.name.rfind("[0]"); bracket != std::string::npos && bracket + 3u == uniform.name.size()) {
+                const auto base = uniform.name.substr(0, bracket);
+                const auto type = uniform.type;
+
+                indices_.emplace(base, index);
+
+                for(int element = 1; element < values[3]; ++element) {
+                    auto tag = base + "[" + std::to_string(element) + "]";
+
+                    indices_.emplace(tag, static_cast<int32_t>(uniforms_.size()));
+
+                    uniforms_.emplace_back(Uniform{tag, type, glGetUniformLocation(handler_, tag.c_str())});
+                }
+            }
+        }
     }
 
 }
@@ -2,18 +2,54 @@
 
 #include "Shader.hpp"
 #include "Bindable.hpp"
+#include "ProgramCache.hpp"
 
-#include <map>
+#include <array>
 #include <memory>
 #include <vector>
 #include <optional>
+#include <unordered_map>
 
 #include <glm/glm.hpp>
 
 namespace glem {
 
+    class ProgramBatch;
+
+    template<typename> struct UniformTypeMap;
+
+    /**
+     * @brief Index of active uniform in program reflection table, resolved once by Program::uniform
+     */
+    template<typename T>
+    struct UniformHandle {
+        int32_t index {-1};
+
+        inline explicit operator bool() const noexcept {
+            return index >= 0;
+        }
+    };
+
+    /**
+     * @brief Program link progress
+     */
+    enum class ProgramStatus {
+        Idle,
+        Linking,
+        Linked,
+        Failed
+    };
+
     class Program : public Bindable {
     public:
+        /**
+         * @brief Uniform upload counters
+         */
+        struct Statistics {
+            size_t issued  {0u};
+            size_t skipped {0u};
+        };
+
         Program();
         ~Program() override;
 
@@ -34,10 +70,95 @@ namespace glem {
         void append(std::unique_ptr<Shader> value) noexcept;
 
         /**
-         * @brief Link program
+         * @brief Same program compiled with additional defines
+         *
+         * Variants are built through ProgramLibrary, so only requested permutations
+         * are ever compiled and each one exactly once per process. Program itself
+         * doesn't have to be linked, it may serve only as template.
+         *
+         * @param defines - "NAME" or "NAME value", merged with defines of appended shaders
+         * @param batch   - if set, new variant is submitted through batch and returned still linking
+         * @return Null if variant failed to link
+         */
+        std::shared_ptr<Program> variant(const std::vector<std::string>& defines, ProgramBatch* batch = nullptr) const noexcept;
+
+        /**
+         * @brief Link program and reflect its active uniforms, blocks until done
+         *
+         * Program is restored from ProgramCache when possible, appended shaders
+         * are compiled only on cache miss.
+         *
+         * @return
+         */
+        bool link() noexcept;
+
+        /**
+         * @brief Issue compilation and link without waiting for result
+         */
+        void submit() noexcept;
+
+        /**
+         * @brief Check if submitted link finished, so finish() won't block
+         *
+         * Without parallel compile support driver completes work on first status
+         * query, so program is always reported ready.
+         *
+         * @return
+         */
+        bool ready() const noexcept;
+
+        /**
+         * @brief Check link result and reflect active uniforms, blocks if not ready
+         * @return
+         */
+        bool finish() noexcept;
+
+        /**
+         * @brief Link progress
+         * @return
+         */
+        ProgramStatus status() const noexcept;
+
+        /**
+         * @brief Local work group size declared by compute stage of linked program
+         * @return Zero size for programs without compute stage
+         */
+        glm::uvec3 workGroupSize() const noexcept;
+
+        /**
+         * @brief Resolve uniform handle, type must match declaration (int also covers bool and samplers)
+         * @param tag - Uniform name
+         * @return Invalid handle if uniform is not active or type mismatches
+         */
+        template<typename T>
+        UniformHandle<T> uniform(const std::string& tag) const noexcept;
+
+        /**
+         * @brief Set uniform value by handle, no lookup involved
+         *
+         * Uploads go through glProgramUniform*, so program doesn't need to be bound.
+         * Value bit-identical to last uploaded one is skipped.
+         *
+         * @param handle - handle resolved from this program, out of range or mismatching one is rejected
+         * @param value
          * @return
          */
-        bool link() const noexcept;
+        bool setUniform(UniformHandle<int> handle, int value) noexcept;
+        bool setUniform(UniformHandle<float> handle, float value) noexcept;
+        bool setUniform(UniformHandle<glm::vec3> handle, const glm::vec3& value) noexcept;
+        bool setUniform(UniformHandle<glm::vec4> handle, const glm::vec4& value) noexcept;
+        bool setUniform(UniformHandle<glm::mat4> handle, const glm::mat4& value) noexcept;
+
+        /**
+         * @brief Uniform uploads issued and skipped since link or last reset
+         * @return
+         */
+        const Statistics& statistics() const noexcept;
+
+        /**
+         * @brief Reset upload counters
+         */
+        void resetStatistics() noexcept;
 
         /**
          * @brief Set uniform value
@@ -52,12 +173,69 @@ namespace glem {
         bool setUniform(const std::string& tag, const glm::mat4& value) noexcept;
 
     private:
-        std::optional<int> resolveUniformLocation(const std::string& value) noexcept;
+        struct Uniform {
+            std::string name;
+
+            uint32_t type     {0u};
+            int32_t  location {-1};
+
+            /**
+             * @brief Last uploaded value, large enough for mat4
+             */
+            std::array<uint32_t, 16> shadow {};
 
-        std::map<std::string, int> location;
+            bool cached {false};
+        };
+
+        /**
+         * @brief Uniform of handle, checked so stale or foreign handle never uploads
+         * @return Null if program isn't linked, index is out of range or type mismatches
+         */
+        template<typename T>
+        Uniform* resolve(UniformHandle<T> handle) noexcept;
+
+        /**
+         * @brief Compare value with shadow copy and update it
+         * @return True if value differs and has to be uploaded
+         */
+        template<typename T>
+        bool changed(Uniform& uniform, const T& value) noexcept;
+
+        /**
+         * @brief Enumerate active default block uniforms through program interface query
+         */
+        void reflect() noexcept;
+
+        /**
+         * @brief Load program from binary cache
+         * @return False if entry is missing or rejected by driver
+         */
+        bool restore(const ProgramCache::Key& key) noexcept;
+
+        /**
+         * @brief Store linked program binary in cache
+         */
+        void save(const ProgramCache::Key& key) const noexcept;
+
+        std::vector<Uniform> uniforms_;
+
+        std::unordered_map<std::string, int32_t> indices_;
+
+        Statistics statistics_;
+
+        ProgramStatus status_ {ProgramStatus::Idle};
+
+        glm::uvec3 workGroupSize_ {0u};
+
+        bool cached_ {false};
+
+        ProgramCache::Key key_;
 
         mutable std::vector<std::unique_ptr<Shader>> shaders_;
 
+        std::vector<ShaderStage> stages_;
+        std::vector<std::string> defines_;
+
     };
 
 }
@@ -0,0 +1,53 @@
+#include "ProgramBatch.hpp"
+#include "Program.hpp"
+
+#include <algorithm>
+
+namespace glem {
+
+    void ProgramBatch::append(std::shared_ptr<Program> program) noexcept
+    {
+        program->submit();
+
+        pending_.emplace_back(std::move(program));
+    }
+
+    bool ProgramBatch::poll() noexcept
+    {
+        auto it = std::remove_if(pending_.begin(), pending_.end(), [this](const auto& program) {
+            if(!program->ready())
+                return false;
+
+            if(!program->finish())
+                ++failed_;
+
+            return true;
+        });
+
+        pending_.erase(it, pending_.end());
+
+        return pending_.empty();
+    }
+
+    bool ProgramBatch::wait() noexcept
+    {
+        for(const auto& program : pending_)
+            if(!program->finish())
+                ++failed_;
+
+        pending_.clear();
+
+        return failed_ == 0u;
+    }
+
+    size_t ProgramBatch::pending() const noexcept
+    {
+        return pending_.size();
+    }
+
+    size_t ProgramBatch::failed() const noexcept
+    {
+        return failed_;
+    }
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+namespace glem {
+
+    class Program;
+
+    /**
+     * @brief Group of programs compiled and linked together
+     *
+     * Every program is submitted as soon as it's appended, status is only
+     * queried from poll() or wait(), so driver with parallel compile support
+     * works on whole batch while caller keeps rendering.
+     */
+    class ProgramBatch {
+    public:
+        ProgramBatch() = default;
+        ~ProgramBatch() = default;
+
+        ProgramBatch(ProgramBatch&&) = delete;
+        ProgramBatch(const ProgramBatch&) = delete;
+
+        ProgramBatch& operator=(ProgramBatch&&) = delete;
+        ProgramBatch& operator=(const ProgramBatch&) = delete;
+
+        /**
+         * @brief Submit program and track it until linked
+         * @param program - program with all stages appended
+         */
+        void append(std::shared_ptr<Program> program) noexcept;
+
+        /**
+         * @brief Finish programs which completed linking, never blocks with parallel compile support
+         * @return True if no program is pending
+         */
+        bool poll() noexcept;
+
+        /**
+         * @brief Finish all pending programs
+         * @return True if all programs linked successfully
+         */
+        bool wait() noexcept;
+
+        /**
+         * @brief Number of programs still linking
+         * @return
+         */
+        size_t pending() const noexcept;
+
+        /**
+         * @brief Number of programs failed to link
+         * @return
+         */
+        size_t failed() const noexcept;
+
+    private:
+        std::vector<std::shared_ptr<Program>> pending_;
+
+        size_t failed_ {0u};
+
+    };
+
+}
@@ -0,0 +1,251 @@
+#include "ProgramCache.hpp"
+
+#include "Log.hpp"
+#include "Hash.hpp"
+#include "Shader.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <filesystem>
+#include <string_view>
+
+#include <glad/glad.h>
+
+namespace {
+    static constexpr const char* TAG = "ProgramCache";
+
+    static constexpr const uint32_t MAGIC   = 0x42504c47u; // "GLPB"
+    static constexpr const uint32_t VERSION = 2u;
+
+    /**
+     * @brief Cache file header, followed by source and binary data
+     */
+    struct Header {
+        uint32_t magic   {MAGIC};
+        uint32_t version {VERSION};
+        uint64_t key     {0u};
+        uint32_t format  {0u};
+        uint32_t size    {0u};
+        uint64_t source  {0u}; // Source size in bytes
+    };
+
+    inline void appendString(std::string& out, std::string_view value) noexcept {
+        const uint64_t length = value.size();
+
+        out.append(reinterpret_cast<const char*>(&length), sizeof (length));
+        out.append(value.data(), value.size());
+    }
+
+    inline std::string_view driverString(GLenum name) noexcept {
+        const auto value = reinterpret_cast<const char*>(glGetString(name));
+
+        return value ? value : "";
+    }
+}
+
+namespace glem {
+
+    ProgramCache &ProgramCache::instance() noexcept
+    {
+        static ProgramCache cache;
+
+        return cache;
+    }
+
+    void ProgramCache::setDirectory(const std::string &value) noexcept
+    {
+        directory_ = value;
+
+        if(directory_.empty())
+            return;
+
+        std::error_code error;
+
+        std::filesystem::create_directories(directory_, error);
+
+        if(error) {
+            Log::w(TAG, "Unable to create cache directory ", directory_, ": ", error.message());
+
+            directory_.clear();
+        }
+    }
+
+    const std::string &ProgramCache::directory() const noexcept
+    {
+        return directory_;
+    }
+
+    bool ProgramCache::enabled() const noexcept
+    {
+        if(directory_.empty())
+            return false;
+
+        int formats {0};
+
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+
+        return formats > 0;
+    }
+
+    ProgramCache::Key ProgramCache::key(const std::vector<std::unique_ptr<Shader>> &shaders) const noexcept
+    {
+        Key key;
+
+        appendString(key.source, driverString(GL_VENDOR));
+        appendString(key.source, driverString(GL_RENDERER));
+        appendString(key.source, driverString(GL_VERSION));
+
+        for(const auto& shader : shaders) {
+            const auto type = static_cast<uint32_t>(shader->type());
+
+            key.source.append(reinterpret_cast<const char*>(&type), sizeof (type));
+
+            appendString(key.source, shader->code());
+        }
+
+        key.hash = Hash{}.append(key.source.data(), key.source.size()).value();
+
+        return key;
+    }
+
+    std::optional<ProgramCache::Binary> ProgramCache::load(const Key& key) const noexcept
+    {
+        std::ifstream file(path(key.hash), std::ios::binary);
+
+        if(!file.is_open())
+            return std::nullopt;
+
+        Header header;
+
+        if(!file.read(reinterpret_cast<char*>(&header), sizeof (header)))
+            return std::nullopt;
+
+        if(header.magic != MAGIC || header.version != VERSION || header.key != key.hash) {
+            Log::w(TAG, "Ignoring corrupted cache entry ", path(key.hash));
+
+            file.close();
+            remove(key);
+
+            return std::nullopt;
+        }
+
+        /**** validate size against file length before allocating, header may be damaged ****/
+        const auto begin = file.tellg();
+
+        file.seekg(0, std::ios::end);
+
+        const auto remaining = file.tellg() - begin;
+
+        file.seekg(begin);
+
+        if(remaining < 0 || header.size == 0u || static_cast<uint64_t>(remaining) != header.source + header.size) {
+            Log::w(TAG, "Ignoring cache entry with invalid size ", path(key.hash));
+
+            file.close();
+            remove(key);
+
+            return std::nullopt;
+        }
+
+        /**** same hash doesn't mean same program, stored inputs must match exactly ****/
+        std::string source;
+
+        if(header.source == key.source.size()) {
+            source.resize(key.source.size());
+
+            if(!file.read(source.data(), static_cast<std::streamsize>(source.size())))
+                source.clear();
+        }
+
+        if(source != key.source) {
+            Log::w(TAG, "Ignoring cache entry stored for other program ", path(key.hash));
+
+            file.close();
+            remove(key);
+
+            return std::nullopt;
+        }
+
+        Binary binary;
+
+        binary.format = header.format;
+        binary.data.resize(header.size);
+
+        if(!file.read(reinterpret_cast<char*>(binary.data.data()), static_cast<std::streamsize>(header.size))) {
+            Log::w(TAG, "Ignoring truncated cache entry ", path(key.hash));
+
+            file.close();
+            remove(key);
+
+            return std::nullopt;
+        }
+
+        return binary;
+    }
+
+    bool ProgramCache::store(const Key& key, const Binary &binary) const noexcept
+    {
+        if(directory_.empty() || binary.data.empty())
+            return false;
+
+        const auto target    = path(key.hash);
+        const auto temporary = target + ".tmp";
+
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+
+            if(!file.is_open()) {
+                Log::w(TAG, "Unable to write cache entry ", temporary);
+                return false;
+            }
+
+            Header header;
+
+            header.key    = key.hash;
+            header.format = binary.format;
+            header.size   = static_cast<uint32_t>(binary.data.size());
+            header.source = key.source.size();
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof (header));
+            file.write(key.source.data(), static_cast<std::streamsize>(key.source.size()));
+            file.write(reinterpret_cast<const char*>(binary.data.data()), static_cast<std::streamsize>(binary.data.size()));
+
+            if(!file) {
+                Log::w(TAG, "Unable to write cache entry ", temporary);
+                return false;
+            }
+        }
+
+        /**** rename so that concurrent readers never see partially written entry ****/
+        std::error_code error;
+
+        std::filesystem::rename(temporary, target, error);
+
+        if(error) {
+            Log::w(TAG, "Unable to write cache entry ", target, ": ", error.message());
+
+            std::filesystem::remove(temporary, error);
+
+            return false;
+        }
+
+        return true;
+    }
+
+    void ProgramCache::remove(const Key& key) const noexcept
+    {
+        std::error_code error;
+
+        std::filesystem::remove(path(key.hash), error);
+    }
+
+    std::string ProgramCache::path(uint64_t key) const noexcept
+    {
+        char name[17];
+
+        std::snprintf(name, sizeof (name), "%016llx", static_cast<unsigned long long>(key));
+
+        return (std::filesystem::path(directory_) / (std::string(name) + ".bin")).string();
+    }
+
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <optional>
+
+namespace glem {
+
+    class Shader;
+
+    /**
+     * @brief On-disk cache of linked program binaries
+     *
+     * Entries are keyed by hash of stage types and sources together with driver
+     * vendor, renderer and version strings, so driver update invalidates them.
+     * Hashed inputs are stored with entry and compared on load, so colliding
+     * key is a miss. Binary rejected by driver is never fatal, program is linked
+     * from source.
+     */
+    class ProgramCache {
+    public:
+        /**
+         * @brief Driver specific program binary
+         */
+        struct Binary {
+            uint32_t format {0u};
+
+            std::vector<uint8_t> data;
+        };
+
+        /**
+         * @brief Entry key, hash names entry and source must match stored one exactly
+         */
+        struct Key {
+            uint64_t hash {0u};
+
+            std::string source; // Driver strings, stage types and code, length prefixed
+        };
+
+        ProgramCache(ProgramCache&&) = delete;
+        ProgramCache(const ProgramCache&) = delete;
+
+        ProgramCache& operator=(ProgramCache&&) = delete;
+        ProgramCache& operator=(const ProgramCache&) = delete;
+
+        /**
+         * @brief Cache instance
+         * @return
+         */
+        static ProgramCache& instance() noexcept;
+
+        /**
+         * @brief Set cache directory, empty path disables cache
+         * @param value
+         */
+        void setDirectory(const std::string& value) noexcept;
+
+        /**
+         * @brief Cache directory
+         * @return
+         */
+        const std::string& directory() const noexcept;
+
+        /**
+         * @brief Check if cache is enabled and driver supports program binaries
+         * @return
+         */
+        bool enabled() const noexcept;
+
+        /**
+         * @brief Cache key of program, requires current context
+         * @param shaders - program stages in attach order
+         * @return
+         */
+        Key key(const std::vector<std::unique_ptr<Shader>>& shaders) const noexcept;
+
+        /**
+         * @brief Load binary
+         * @param key
+         * @return Empty if entry is missing, corrupted or stored for other source
+         */
+        std::optional<Binary> load(const Key& key) const noexcept;
+
+        /**
+         * @brief Store binary, replaces existing entry
+         * @param key
+         * @param binary
+         * @return
+         */
+        bool store(const Key& key, const Binary& binary) const noexcept;
+
+        /**
+         * @brief Remove entry, used when driver rejects stored binary
+         * @param key
+         */
+        void remove(const Key& key) const noexcept;
+
+    private:
+        ProgramCache() = default;
+        ~ProgramCache() = default;
+
+        std::string path(uint64_t key) const noexcept;
+
+        std::string directory_;
+
+    };
+
+}
@@ -0,0 +1,115 @@
+#include "ProgramLibrary.hpp"
+#include "ProgramBatch.hpp"
+#include "Program.hpp"
+
+#include "Log.hpp"
+
+#include <algorithm>
+
+namespace {
+    static constexpr const char* TAG = "ProgramLibrary";
+}
+
+namespace glem {
+
+    ProgramLibrary &ProgramLibrary::instance() noexcept
+    {
+        static ProgramLibrary library;
+
+        return library;
+    }
+
+    std::shared_ptr<Program> ProgramLibrary::acquire(const std::vector<ShaderStage> &stages, std::vector<std::string> defines, ProgramBatch *batch) noexcept
+    {
+        std::sort(defines.begin(), defines.end());
+
+        defines.erase(std::unique(defines.begin(), defines.end()), defines.end());
+
+        /**** key is preprocessed code itself, so include changes produce distinct programs and hashes never collide ****/
+        std::vector<std::unique_ptr<Shader>> shaders;
+
+        std::string key;
+
+        for(const auto& stage : stages) {
+            shaders.emplace_back(std::make_unique<Shader>(stage.source, stage.type, defines));
+
+            const auto& code = shaders.back()->code();
+
+            const uint32_t type   = static_cast<uint32_t>(stage.type);
+            const uint64_t length = code.size();
+
+            key.append(reinterpret_cast<const char*>(&type),   sizeof (type));
+            key.append(reinterpret_cast<const char*>(&length), sizeof (length));
+            key.append(code);
+        }
+
+        if(auto it = programs_.find(key); it != programs_.end()) {
+            auto program = it->second;
+
+            if(program->status() != ProgramStatus::Failed) {
+                if(batch) {
+                    batch->append(program);
+
+                    return program;
+                }
+
+                /**** program may still be linking for earlier batched request ****/
+                if(program->status() == ProgramStatus::Linked || program->finish())
+                    return program;
+
+                Log::e(TAG, "Failed to link program.");
+
+                programs_.erase(it);
+
+                return nullptr;
+            }
+
+            programs_.erase(it);
+        }
+
+        auto program = std::make_shared<Program>();
+
+        for(auto& shader : shaders)
+            program->append(std::move(shader));
+
+        if(batch) {
+            batch->append(program);
+        }
+        else if(!program->link()) {
+            Log::e(TAG, "Failed to link program.");
+            return nullptr;
+        }
+
+        programs_.emplace(std::move(key), program);
+
+        return program;
+    }
+
+    size_t ProgramLibrary::collect() noexcept
+    {
+        size_t count {0u};
+
+        for(auto it = programs_.begin(); it != programs_.end();) {
+            if(it->second.use_count() == 1) {
+                it = programs_.erase(it);
+                ++count;
+            }
+            else {
+                ++it;
+            }
+        }
+
+        return count;
+    }
+
+    void ProgramLibrary::clear() noexcept
+    {
+        programs_.clear();
+    }
+
+    size_t ProgramLibrary::size() const noexcept
+    {
+        return programs_.size();
+    }
+
+}
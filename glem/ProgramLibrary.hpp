@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Shader.hpp"
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+namespace glem {
+
+    class Program;
+    class ProgramBatch;
+
+    /**
+     * @brief Process wide registry of programs keyed by stage sources preprocessed with defines
+     *
+     * Identical programs requested by different scenes share single GL program.
+     * Library keeps its own reference, so programs survive scene switches until
+     * collect() is called.
+     */
+    class ProgramLibrary {
+    public:
+        ProgramLibrary(ProgramLibrary&&) = delete;
+        ProgramLibrary(const ProgramLibrary&) = delete;
+
+        ProgramLibrary& operator=(ProgramLibrary&&) = delete;
+        ProgramLibrary& operator=(const ProgramLibrary&) = delete;
+
+        /**
+         * @brief Library instance
+         * @return
+         */
+        static ProgramLibrary& instance() noexcept;
+
+        /**
+         * @brief Get shared program, compile and link it on first request
+         *
+         * Stages are preprocessed with defines before lookup, define order
+         * doesn't matter.
+         *
+         * @param stages  - program stages
+         * @param defines - preprocessor defines
+         * @param batch   - if set, new program is submitted through batch and returned still linking,
+         *                  otherwise returned program is always linked
+         * @return Null if program failed to link
+         */
+        std::shared_ptr<Program> acquire(const std::vector<ShaderStage>& stages, std::vector<std::string> defines = {}, ProgramBatch* batch = nullptr) noexcept;
+
+        /**
+         * @brief Release programs not referenced outside of library
+         * @return Number of released programs
+         */
+        size_t collect() noexcept;
+
+        /**
+         * @brief Release all programs, must be called while context is still current
+         */
+        void clear() noexcept;
+
+        /**
+         * @brief Number of programs in library
+         * @return
+         */
+        size_t size() const noexcept;
+
+    private:
+        ProgramLibrary() = default;
+        ~ProgramLibrary() = default;
+
+        /**** keyed by stage types and preprocessed code, hash only selects bucket ****/
+        std::unordered_map<std::string, std::shared_ptr<Program>> programs_;
+
+    };
+
+}
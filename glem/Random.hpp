@@ -0,0 +1,139 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace glem {
+
+    /**
+     * @brief Seedable xoshiro128+ generator
+     *
+     * Runs 8 independent lanes side by side, so every refill is a straight
+     * vectorizable loop over uint32 lanes. Owns no global state and is cheap
+     * to copy, one generator per emitter/thread.
+     */
+    class Random {
+    public:
+        static constexpr const size_t LANES = 8u;
+
+        explicit Random(uint64_t value = 0x853c49e6748fea9bull) noexcept {
+            seed(value);
+        }
+
+        ~Random() = default;
+
+        /**
+         * @brief Reset generator state
+         * @param value - seed
+         */
+        inline void seed(uint64_t value) noexcept {
+            /**** splitmix64 seeding, guarantees non zero lanes ****/
+            auto splitmix = [&value]() noexcept {
+                auto z = (value += 0x9e3779b97f4a7c15ull);
+
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+
+                return z ^ (z >> 31);
+            };
+
+            for(size_t i = 0; i < LANES; ++i) {
+                const auto a = splitmix();
+                const auto b = splitmix();
+
+                s0_[i] = static_cast<uint32_t>(a);
+                s1_[i] = static_cast<uint32_t>(a >> 32) | 1u;
+                s2_[i] = static_cast<uint32_t>(b);
+                s3_[i] = static_cast<uint32_t>(b >> 32);
+            }
+
+            cursor_ = LANES;
+        }
+
+        /**
+         * @brief Next 32-bit value
+         * @return
+         */
+        inline uint32_t next() noexcept {
+            if(cursor_ == LANES) {
+                step(cache_.data());
+                cursor_ = 0u;
+            }
+
+            return cache_[cursor_++];
+        }
+
+        /**
+         * @brief Uniform float in [min, max)
+         * @param min
+         * @param max
+         * @return
+         */
+        inline float uniform(float min = 0.0f, float max = 1.0f) noexcept {
+            return min + (max - min) * toFloat(next());
+        }
+
+        /**
+         * @brief Fill range with uniform floats in [min, max)
+         * @param out   - destination
+         * @param count - number of values
+         * @param min
+         * @param max
+         */
+        inline void uniform(float* out, size_t count, float min = 0.0f, float max = 1.0f) noexcept {
+            const auto range = max - min;
+
+            std::array<uint32_t, LANES> values;
+
+            size_t i = 0;
+
+            for(; i + LANES <= count; i += LANES) {
+                step(values.data());
+
+                for(size_t j = 0; j < LANES; ++j)
+                    out[i + j] = min + range * toFloat(values[j]);
+            }
+
+            for(; i < count; ++i)
+                out[i] = uniform(min, max);
+        }
+
+    private:
+        static inline float toFloat(uint32_t value) noexcept {
+            return static_cast<float>(value >> 8) * (1.0f / 16777216.0f);
+        }
+
+        static inline uint32_t rotl(uint32_t value, int k) noexcept {
+            return (value << k) | (value >> (32 - k));
+        }
+
+        inline void step(uint32_t* out) noexcept {
+            for(size_t i = 0; i < LANES; ++i) {
+                out[i] = s0_[i] + s3_[i];
+
+                const auto t = s1_[i] << 9;
+
+                s2_[i] ^= s0_[i];
+                s3_[i] ^= s1_[i];
+                s1_[i] ^= s2_[i];
+                s0_[i] ^= s3_[i];
+
+                s2_[i] ^= t;
+
+                s3_[i] = rotl(s3_[i], 11);
+            }
+        }
+
+        alignas(32) std::array<uint32_t, LANES> s0_;
+        alignas(32) std::array<uint32_t, LANES> s1_;
+        alignas(32) std::array<uint32_t, LANES> s2_;
+        alignas(32) std::array<uint32_t, LANES> s3_;
+
+        alignas(32) std::array<uint32_t, LANES> cache_;
+
+        size_t cursor_ {LANES};
+
+    };
+
+}
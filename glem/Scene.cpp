@@ -10,6 +10,9 @@
 #include "Buffer.hpp"
 #include "Shader.hpp"
 #include "Program.hpp"
+#include "ProgramBatch.hpp"
+#include "ProgramLibrary.hpp"
+#include "ShaderPreprocessor.hpp"
 
 #include "Image.hpp"
 #include "Texture.hpp"
@@ -18,40 +21,96 @@
 
 #include "Mesh.hpp"
 #include "Particle.hpp"
+#include "Collision.hpp"
+#include "ThreadPool.hpp"
 //#include "Primitives.hpp"
 
 namespace {
     static constexpr const char* TAG = "Scene";
-}
 
-namespace glem {
+    /**** uniform block binding points, must match shader declarations ****/
+    static constexpr const uint32_t CAMERA_BINDING = 0u;
+    static constexpr const uint32_t LIGHT_BINDING  = 1u;
 
-    /**** ParticleScene ****/
-    ParticleScene::ParticleScene()
-    {
-        attach();
+    glem::UniformLayout cameraLayout() noexcept {
+        glem::UniformLayout layout;
+
+        layout.push(glem::MemberType::Matrix4f, "uProjectionMatrix")
+              .push(glem::MemberType::Matrix4f, "uViewMatrix")
+              .push(glem::MemberType::Vector3f, "uViewPosition");
+
+        return layout;
     }
 
-    ParticleScene::~ParticleScene()
-    {
-        detach();
+    glem::UniformLayout lightLayout() noexcept {
+        glem::UniformLayout layout;
+
+        layout.push(glem::MemberType::Vector3f, "position")
+              .push(glem::MemberType::Vector3f, "ambient")
+              .push(glem::MemberType::Vector3f, "diffuse")
+              .push(glem::MemberType::Vector3f, "specular")
+              .push(glem::MemberType::Float,    "constant")
+              .push(glem::MemberType::Float,    "linear")
+              .push(glem::MemberType::Float,    "quadratic");
+
+        return layout;
     }
 
-    void ParticleScene::attach() noexcept
-    {
-        const auto& vs = R"glsl(
+    /**** shared GLSL, stages pull common declarations in through #include ****/
+    static constexpr const char* CAMERA_GLSL = R"glsl(
+                         layout(std140, binding = 0) uniform Camera {
+                            mat4 uProjectionMatrix;
+                            mat4 uViewMatrix;
+                            vec3 uViewPosition;
+                         };
+                         )glsl";
+
+    static constexpr const char* LIGHT_GLSL = R"glsl(
+                         layout(std140, binding = 1) uniform Light {
+                            vec3 position;
+                            vec3 ambient;
+                            vec3 diffuse;
+                            vec3 specular;
+                            float constant;
+                            float linear;
+                            float quadratic;
+                         } uLight;
+                         )glsl";
+
+    /**** NO_ATTENUATION drops distance falloff at compile time ****/
+    static constexpr const char* PHONG_GLSL = R"glsl(
+                         #include "camera.glsl"
+                         #include "light.glsl"
+                         vec3 phong(vec3 position, vec3 normal, vec3 diffuseColor, vec3 specularColor, float shininess) {
+                            vec3 N = normalize(normal);
+                            vec3 L = normalize(uLight.position - position);
+                            vec3 V = normalize(uViewPosition - position);
+                            vec3 R = reflect(-L, N);
+                            vec3 ambient  = uLight.ambient * diffuseColor;
+                            vec3 diffuse  = uLight.diffuse * max(dot(N, L), 0.0f) * diffuseColor;
+                            vec3 specular = uLight.specular * pow(max(dot(V, R), 0.0f), shininess) * specularColor;
+                         #ifdef NO_ATTENUATION
+                            return ambient + diffuse + specular;
+                         #else
+                            float D = length(uLight.position - position);
+                            float attenuation = 1.0f / (uLight.constant + uLight.linear * D + uLight.quadratic * D * D);
+                            return (ambient + diffuse + specular) * attenuation;
+                         #endif
+                         }
+                         )glsl";
+
+    static constexpr const char* LIGHT_VS = R"glsl(
                          #version 450
+                         #include "camera.glsl"
                          layout(location = 0) in vec3 vPosition;
                          layout(location = 1) in vec3 vNormal;
-                            uniform mat4 uProjectionMatrix;
-                            uniform mat4 uViewMatrix;
                             uniform mat4 uModelMatrix = mat4(1.0f);
                          void main() {
                             gl_Position = uProjectionMatrix * uViewMatrix * uModelMatrix * vec4(vPosition, 1.0f);
                          }
                          )glsl";
 
-        const auto& ps = R"glsl(
+    static constexpr const char* LIGHT_PS = R"glsl(
                          #version 450
                          layout(location = 0) out vec4 FragmentColor;
                             uniform vec4 uColor = vec4(1.0f, 1.0f, 1.0f, 1.0f);
@@ -60,21 +119,16 @@ namespace glem {
                          }
                          )glsl";
 
-        lightProgram_ = std::make_shared<Program>();
-        lightProgram_->append(std::make_unique<Shader>(vs, ShaderType::VS));
-        lightProgram_->append(std::make_unique<Shader>(ps, ShaderType::PS));
-
-        if(!lightProgram_->link()) {
-            Log::e(TAG, "Failed to link light shader program.");
-            return;
-        }
-
-        const auto& phong_vs = R"glsl(
+    /**** TEXTURED adds uv stream ****/
+    static constexpr const char* PHONG_VS = R"glsl(
                          #version 450
+                         #include "camera.glsl"
                          layout(location = 0) in vec3 vPosition;
                          layout(location = 1) in vec3 vNormal;
-                         uniform mat4 uProjectionMatrix;
-                         uniform mat4 uViewMatrix;
+                         #ifdef TEXTURED
+                         layout(location = 2) in vec2 vUv;
+                         out vec2 fUv;
+                         #endif
                          uniform mat4 uModelMatrix = mat4(1.0f);
                          out vec3 fPosition;
                          out vec3 fNormal;
@@ -82,70 +136,217 @@ namespace glem {
                             gl_Position = uProjectionMatrix * uViewMatrix * uModelMatrix * vec4(vPosition, 1.0f);
                             fPosition = vec3(uModelMatrix * vec4(vPosition, 1.0f));
                             fNormal   = mat3(transpose(inverse(uModelMatrix))) * vNormal;
+                         #ifdef TEXTURED
+                            fUv       = vUv;
+                         #endif
                          }
                          )glsl";
 
-        const auto& phong_ps = R"glsl(
+    /**** TEXTURED samples diffuse and specular maps, INSTANCED takes color from vertex stage, otherwise uMaterial.color ****/
+    static constexpr const char* PHONG_PS = R"glsl(
                          #version 450
+                         #include "phong.glsl"
                          layout(location = 0) out vec4 FragmentColor;
-                         uniform vec3 uViewPosition;
                          struct Material {
+                         #if defined(TEXTURED)
+                            sampler2D diffuse;
+                            sampler2D specular;
+                         #elif !defined(INSTANCED)
                             vec4 color;
+                         #endif
                             float shininess;
                          };
-                         struct Light {
-                            vec3 position;
-                            vec3 ambient;
-                            vec3 diffuse;
-                            vec3 specular;
-                            float constant;
-                            float linear;
-                            float quadratic;
-                         };
-                         uniform Light uLight;
                          uniform Material uMaterial;
                          in vec3 fPosition;
                          in vec3 fNormal;
+                         #ifdef TEXTURED
+                         in vec2 fUv;
+                         #endif
+                         #ifdef INSTANCED
+                         in vec4 fColor;
+                         #endif
                          void main() {
-                            vec3 ambient = uLight.ambient;
-                            vec3 N = normalize(fNormal);
-                            vec3 L = normalize(uLight.position - fPosition);
-                            vec3 diffuse = uLight.diffuse * max(dot(N, L), 0.0f);
-                            vec3 V = normalize(uViewPosition - fPosition);
-                            vec3 R = reflect(-L, N);
-                            vec3 specular = uLight.specular * pow(max(dot(V, R), 0.0f), uMaterial.shininess);
-                            float D = length(uLight.position - fPosition);
-                            float attenuation = 1.0f / (uLight.constant + uLight.linear * D + uLight.quadratic * D * D);
-                            ambient  *= attenuation;
-                            diffuse  *= attenuation;
-                            specular *= attenuation;
-                            FragmentColor = vec4(ambient + diffuse + specular, 1.0f) * uMaterial.color;
+                         #ifdef TEXTURED
+                            vec3 diffuseColor  = texture(uMaterial.diffuse, fUv).rgb;
+                            vec3 specularColor = texture(uMaterial.specular, fUv).rgb;
+                         #else
+                            vec3 diffuseColor  = vec3(1.0f);
+                            vec3 specularColor = vec3(1.0f);
+                         #endif
+                            vec4 color = vec4(phong(fPosition, fNormal, diffuseColor, specularColor, uMaterial.shininess), 1.0f);
+                         #if defined(TEXTURED)
+                            FragmentColor = color;
+                         #elif defined(INSTANCED)
+                            FragmentColor = color * fColor;
+                         #else
+                            FragmentColor = color * uMaterial.color;
+                         #endif
                          }
                          )glsl";
 
-        modelProgram_ = std::make_shared<Program>();
-        modelProgram_->append(std::make_unique<Shader>(phong_vs, ShaderType::VS));
-        modelProgram_->append(std::make_unique<Shader>(phong_ps, ShaderType::PS));
+    void registerShaderIncludes() noexcept {
+        auto& preprocessor = glem::ShaderPreprocessor::instance();
 
-        if(!modelProgram_->link()) {
-            Log::e(TAG, "Failed to link model shader program.");
-            return;
-        }
+        preprocessor.add("camera.glsl", CAMERA_GLSL);
+        preprocessor.add("light.glsl",  LIGHT_GLSL);
+        preprocessor.add("phong.glsl",  PHONG_GLSL);
+    }
+}
 
-        modelProgram_->bind();
+namespace glem {
 
-        /**** material setup ****/
-        modelProgram_->setUniform("uMaterial.color",     glm::vec4{1.0f, 0.0f, 1.0f, 1.0f});
-        modelProgram_->setUniform("uMaterial.shininess", 32.0f);
-
-        /**** light setup ****/
-        modelProgram_->setUniform("uLight.position",  lightPosition_);
-        modelProgram_->setUniform("uLight.ambient",   glm::vec3{0.2f, 0.2f, 0.2f});
-        modelProgram_->setUniform("uLight.diffuse",   glm::vec3{0.5f, 0.5f, 0.5f});
-        modelProgram_->setUniform("uLight.specular",  glm::vec3{1.0f, 1.0f, 1.0f});
-        modelProgram_->setUniform("uLight.constant",  1.0f);
-        modelProgram_->setUniform("uLight.linear",    0.09f);
-        modelProgram_->setUniform("uLight.quadratic", 0.032f);
+    /**** ParticleScene ****/
+    ParticleScene::ParticleScene()
+    {
+        attach();
+    }
+
+    ParticleScene::~ParticleScene()
+    {
+        detach();
+    }
+
+    void ParticleScene::attach() noexcept
+    {
+        /**** all programs compile together while scene keeps rendering, update() polls results ****/
+        batch_ = std::make_unique<ProgramBatch>();
+
+        registerShaderIncludes();
+
+        lightProgram_ = ProgramLibrary::instance().acquire({{ShaderType::VS, LIGHT_VS}, {ShaderType::PS, LIGHT_PS}}, {}, batch_.get());
+
+        /**** phong template, compiled only in variants requested below ****/
+        Program phong;
+        phong.append(std::make_unique<Shader>(PHONG_VS, ShaderType::VS));
+        phong.append(std::make_unique<Shader>(PHONG_PS, ShaderType::PS));
+
+        modelProgram_ = phong.variant({}, batch_.get());
+
+        const auto& phong_instanced_vs = R"glsl(
+                         #version 450
+                         layout(location = 0) in vec3 vPosition;
+                         layout(location = 1) in vec3 vNormal;
+                         layout(location = 2) in vec4 iPosition;
+                         layout(location = 3) in vec3 iRotation;
+                         layout(location = 4) in vec4 iColor;
+                         #include "camera.glsl"
+                         out vec3 fPosition;
+                         out vec3 fNormal;
+                         out vec4 fColor;
+                         void main() {
+                            vec3 c = cos(iRotation);
+                            vec3 s = sin(iRotation);
+                            mat3 Rx = mat3(1.0f, 0.0f, 0.0f, 0.0f, c.x, s.x, 0.0f, -s.x, c.x);
+                            mat3 Ry = mat3(c.y, 0.0f, -s.y, 0.0f, 1.0f, 0.0f, s.y, 0.0f, c.y);
+                            mat3 Rz = mat3(c.z, s.z, 0.0f, -s.z, c.z, 0.0f, 0.0f, 0.0f, 1.0f);
+                            mat3 R  = Rx * Ry * Rz;
+                            fPosition = R * (vPosition * iPosition.w) + iPosition.xyz;
+                            fNormal   = R * vNormal;
+                            fColor    = iColor;
+                            gl_Position = uProjectionMatrix * uViewMatrix * vec4(fPosition, 1.0f);
+                         }
+                         )glsl";
+
+        instancedModelProgram_ = ProgramLibrary::instance().acquire({{ShaderType::VS, phong_instanced_vs}, {ShaderType::PS, PHONG_PS}}, {"INSTANCED"}, batch_.get());
+
+        const auto& phong_compute_vs = R"glsl(
+                         #version 450
+                         layout(location = 0) in vec3 vPosition;
+                         layout(location = 1) in vec3 vNormal;
+                         struct Particle {
+                            vec4 position;
+                            vec4 velocity;
+                            vec4 rotation;
+                         };
+                         layout(std430, binding = 0) readonly buffer Particles {
+                            Particle particles[];
+                         };
+                         layout(std430, binding = 1) readonly buffer Alive {
+                            uint alive[];
+                         };
+                         layout(std430, binding = 2) readonly buffer Curves {
+                            vec4  color[64];
+                            float size[64];
+                            float velocityScale[64];
+                         };
+                         #include "camera.glsl"
+                         out vec3 fPosition;
+                         out vec3 fNormal;
+                         out vec4 fColor;
+                         void main() {
+                            Particle p = particles[alive[gl_InstanceID]];
+                            float x = clamp(1.0f - p.position.w / p.velocity.w, 0.0f, 1.0f) * 63.0f;
+                            int   i = min(int(x), 62);
+                            float f = x - float(i);
+                            float size = mix(size[i], size[i + 1], f);
+                            vec3 c = cos(p.rotation.xyz);
+                            vec3 s = sin(p.rotation.xyz);
+                            mat3 Rx = mat3(1.0f, 0.0f, 0.0f, 0.0f, c.x, s.x, 0.0f, -s.x, c.x);
+                            mat3 Ry = mat3(c.y, 0.0f, -s.y, 0.0f, 1.0f, 0.0f, s.y, 0.0f, c.y);
+                            mat3 Rz = mat3(c.z, s.z, 0.0f, -s.z, c.z, 0.0f, 0.0f, 0.0f, 1.0f);
+                            mat3 R  = Rx * Ry * Rz;
+                            fPosition = R * (vPosition * size) + p.position.xyz;
+                            fNormal   = R * vNormal;
+                            fColor    = mix(color[i], color[i + 1], f);
+                            gl_Position = uProjectionMatrix * uViewMatrix * vec4(fPosition, 1.0f);
+                         }
+                         )glsl";
+
+        computeModelProgram_ = ProgramLibrary::instance().acquire({{ShaderType::VS, phong_compute_vs}, {ShaderType::PS, PHONG_PS}}, {"INSTANCED"}, batch_.get());
+
+        const auto& phong_analytic_vs = R"glsl(
+                         #version 450
+                         layout(location = 0) in vec3 vPosition;
+                         layout(location = 1) in vec3 vNormal;
+                         layout(location = 2) in vec4 iVelocity;
+                         layout(location = 3) in vec3 iRotation;
+                         layout(std430, binding = 0) readonly buffer Curves {
+                            vec4  color[64];
+                            float size[64];
+                            float distance[64];
+                         };
+                         uniform float uTime;
+                         uniform float uPeriod;
+                         uniform float uLife;
+                         #include "camera.glsl"
+                         out vec3 fPosition;
+                         out vec3 fNormal;
+                         out vec4 fColor;
+                         void main() {
+                            float local = mod(uTime - iVelocity.w, uPeriod);
+                            bool  alive = uTime >= iVelocity.w && local < uLife;
+                            float x = clamp(local / uLife, 0.0f, 1.0f) * 63.0f;
+                            int   i = min(int(x), 62);
+                            float f = x - float(i);
+                            float size     = alive ? mix(size[i], size[i + 1], f) : 0.0f;
+                            float distance = mix(distance[i], distance[i + 1], f) * uLife;
+                            vec3 rotation = iRotation + iVelocity.xyz * distance;
+                            vec3 c = cos(rotation);
+                            vec3 s = sin(rotation);
+                            mat3 Rx = mat3(1.0f, 0.0f, 0.0f, 0.0f, c.x, s.x, 0.0f, -s.x, c.x);
+                            mat3 Ry = mat3(c.y, 0.0f, -s.y, 0.0f, 1.0f, 0.0f, s.y, 0.0f, c.y);
+                            mat3 Rz = mat3(c.z, s.z, 0.0f, -s.z, c.z, 0.0f, 0.0f, 0.0f, 1.0f);
+                            mat3 R  = Rx * Ry * Rz;
+                            fPosition = R * (vPosition * size) + iVelocity.xyz * distance;
+                            fNormal   = R * vNormal;
+                            fColor    = mix(color[i], color[i + 1], f);
+                            gl_Position = uProjectionMatrix * uViewMatrix * vec4(fPosition, 1.0f);
+                         }
+                         )glsl";
+
+        analyticModelProgram_ = ProgramLibrary::instance().acquire({{ShaderType::VS, phong_analytic_vs}, {ShaderType::PS, PHONG_PS}}, {"INSTANCED"}, batch_.get());
+
+        /**** camera and light blocks, shared by all programs ****/
+        cameraBuffer_ = std::make_unique<UniformBuffer>(cameraLayout());
+
+        lightBuffer_ = std::make_unique<UniformBuffer>(lightLayout());
+        lightBuffer_->set("position",  lightPosition_);
+        lightBuffer_->set("ambient",   glm::vec3{0.2f, 0.2f, 0.2f});
+        lightBuffer_->set("diffuse",   glm::vec3{0.5f, 0.5f, 0.5f});
+        lightBuffer_->set("specular",  glm::vec3{1.0f, 1.0f, 1.0f});
+        lightBuffer_->set("constant",  1.0f);
+        lightBuffer_->set("linear",    0.09f);
+        lightBuffer_->set("quadratic", 0.032f);
 
         const auto projection = glm::perspective(glm::radians(45.0f),
                                                  static_cast<float>(glem::Application::instance().window().width()) / static_cast<float>(glem::Application::instance().window().height()),
@@ -182,7 +383,75 @@ namespace glem {
         lightVertexArray_->append(std::make_unique<VertexBuffer>(sphere.buffer));
         lightVertexArray_->append(std::make_unique<IndexBuffer>(sphere.indices));
 
-        emitter_ = std::make_unique<ParticleEmitter>();
+        EmitterDescriptor descriptor;
+
+        descriptor.capacity  = 10000u;
+        descriptor.spawnRate = 60.0f;
+        descriptor.life      = 8.0f;
+        descriptor.curlNoise = CurlNoiseField{};
+
+        emitter_ = std::make_unique<ParticleEmitter>(descriptor);
+        threads_ = std::make_unique<ThreadPool>();
+        emitter_->attachInstanceBuffer(*modelVertexArray_);
+
+        auto colliders = std::make_shared<Colliders>();
+
+        colliders->planes.push_back({glm::vec3{0.0f, 1.0f, 0.0f}, -10.0f});
+        colliders->spheres.push_back({glm::vec3{10.0f, 0.0f, 0.0f}, 4.0f});
+        colliders->radius = 0.5f;
+
+        emitter_->setColliders(colliders);
+
+        EmitterDescriptor compute;
+
+        compute.capacity = 1u << 20;
+
+        computeEmitter_ = std::make_unique<ComputeParticleEmitter>(compute);
+
+        /**** analytic emitter needs own mesh vertex array, instance attributes start right after mesh ones ****/
+        analyticVertexArray_ = std::make_shared<VertexArray>();
+        analyticVertexArray_->append(std::make_unique<VertexBuffer>(cube.buffer));
+        analyticVertexArray_->append(std::make_unique<IndexBuffer>(cube.indices));
+
+        /**** closed form emitter has no particle state, so no curl noise or colliders, one life time of records ****/
+        EmitterDescriptor analytic;
+
+        analytic.capacity  = 480u;
+        analytic.spawnRate = 60.0f;
+        analytic.life      = 8.0f;
+
+        analyticEmitter_ = std::make_unique<AnalyticParticleEmitter>(analytic);
+        analyticEmitter_->attachSpawnBuffer(*analyticVertexArray_);
+
+        /**** fluid emitter poured into box ****/
+        fluidVertexArray_ = std::make_shared<VertexArray>();
+        fluidVertexArray_->append(std::make_unique<VertexBuffer>(cube.buffer));
+        fluidVertexArray_->append(std::make_unique<IndexBuffer>(cube.indices));
+
+        EmitterDescriptor fluid;
+
+        fluid.capacity      = 4000u;
+        fluid.spawnRate     = 400.0f;
+        fluid.life          = 60.0f;
+        fluid.velocity      = {0.0f, 1.0f};
+        fluid.sizeOverLife  = Curve<float>{0.3f};
+        fluid.colorOverLife = Curve<glm::vec4>{glm::vec4{0.2f, 0.4f, 1.0f, 1.0f}};
+        fluid.fluid         = FluidDescriptor{};
+
+        fluidEmitter_ = std::make_unique<ParticleEmitter>(fluid);
+        fluidEmitter_->attachInstanceBuffer(*fluidVertexArray_);
+
+        auto container = std::make_shared<Colliders>();
+
+        container->planes.push_back({glm::vec3{ 0.0f, 1.0f,  0.0f}, -5.0f});
+        container->planes.push_back({glm::vec3{ 1.0f, 0.0f,  0.0f}, -5.0f});
+        container->planes.push_back({glm::vec3{-1.0f, 0.0f,  0.0f}, -5.0f});
+        container->planes.push_back({glm::vec3{ 0.0f, 0.0f,  1.0f}, -5.0f});
+        container->planes.push_back({glm::vec3{ 0.0f, 0.0f, -1.0f}, -5.0f});
+        container->restitution = 0.1f;
+        container->radius      = 0.15f;
+
+        fluidEmitter_->setColliders(container);
 
         glEnable(GL_CULL_FACE);
         glEnable(GL_DEPTH_TEST);
@@ -200,6 +469,15 @@ namespace glem {
     void ParticleScene::update(float deltaTime) noexcept
     {
         if(visible()) {
+            if(batch_ && batch_->poll()) {
+                if(batch_->failed() != 0u)
+                    Log::e(TAG, "Failed to link ", batch_->failed(), " particle shader programs.");
+
+                setupPrograms();
+
+                batch_.reset();
+            }
+
             if(Keyboard::pressed(Keyboard::Key::F1)) {
                 const auto projection = glm::perspective(glm::radians(45.0f),
                                                          static_cast<float>(glem::Application::instance().window().width()) / static_cast<float>(glem::Application::instance().window().height()),
@@ -222,8 +500,32 @@ namespace glem {
                 camera_->setPosition({0.0f, 0.0f, 50.0f});
             }
 
-            emitter_->spawn();
-            emitter_->update(deltaTime);
+            if(Keyboard::pressed(Keyboard::Key::F3))
+                mode_ = Mode::Instanced;
+            if(Keyboard::pressed(Keyboard::Key::F4))
+                mode_ = Mode::PerParticle;
+            if(Keyboard::pressed(Keyboard::Key::F5))
+                mode_ = Mode::Compute;
+            if(Keyboard::pressed(Keyboard::Key::F6))
+                mode_ = Mode::Analytic;
+            if(Keyboard::pressed(Keyboard::Key::F7))
+                mode_ = Mode::Fluid;
+
+            switch (mode_) {
+            case Mode::Compute:
+                computeEmitter_->spawn(1000u);
+                computeEmitter_->update(Application::instance().context(), deltaTime);
+                break;
+            case Mode::Analytic:
+                analyticEmitter_->update(deltaTime);
+                break;
+            case Mode::Fluid:
+                fluidEmitter_->update(deltaTime, *threads_);
+                break;
+            default:
+                emitter_->update(deltaTime, *threads_);
+                break;
+            }
 
             camera_->update(deltaTime);
 
@@ -250,31 +552,87 @@ namespace glem {
     {
         if(visible()) {
             /**** particle rendering ****/
-            modelProgram_->bind();
-            modelProgram_->setUniform("uProjectionMatrix", camera_->projection());
-            modelProgram_->setUniform("uViewMatrix",       camera_->view());
-            modelProgram_->setUniform("uViewPosition",     camera_->position());
-            modelProgram_->setUniform("uLight.position",   lightPosition_);
+            auto& program = mode_ == Mode::Instanced   ? instancedModelProgram_ :
+                            mode_ == Mode::PerParticle ? modelProgram_          :
+                            mode_ == Mode::Compute     ? computeModelProgram_   :
+                            mode_ == Mode::Analytic    ? analyticModelProgram_  :
+                                                         instancedModelProgram_;
+
+            cameraBuffer_->set("uProjectionMatrix", camera_->projection());
+            cameraBuffer_->set("uViewMatrix",       camera_->view());
+            cameraBuffer_->set("uViewPosition",     camera_->position());
+            cameraBuffer_->update();
+            cameraBuffer_->bindBase(CAMERA_BINDING);
+
+            lightBuffer_->set("position", lightPosition_);
+            lightBuffer_->update();
+            lightBuffer_->bindBase(LIGHT_BINDING);
 
             Application::instance().context().beginFrame({0.1f, 0.1f, 0.1f, 1.0f});
 
-            modelVertexArray_->bind();
-
-            emitter_->render(Application::instance().context(), modelProgram_, modelVertexArray_, GL_TRIANGLES);
+            /**** programs still linking or failed are skipped ****/
+            const auto linked = [this](const auto& program) noexcept {
+                return !batch_ && program && program->status() == ProgramStatus::Linked;
+            };
+
+            if(linked(program)) {
+                program->bind();
+
+                modelVertexArray_->bind();
+
+                if(mode_ == Mode::Instanced || mode_ == Mode::PerParticle)
+                    emitter_->sort(camera_->position());
+                if(mode_ == Mode::Fluid)
+                    fluidEmitter_->sort(camera_->position());
+
+                switch (mode_) {
+                case Mode::Instanced:
+                    emitter_->renderInstanced(Application::instance().context(), program, modelVertexArray_, GL_TRIANGLES);
+                    break;
+                case Mode::PerParticle:
+                    emitter_->render(Application::instance().context(), program, modelVertexArray_, GL_TRIANGLES);
+                    break;
+                case Mode::Compute:
+                    computeEmitter_->render(Application::instance().context(), program, modelVertexArray_, GL_TRIANGLES);
+                    break;
+                case Mode::Analytic:
+                    analyticEmitter_->render(Application::instance().context(), analyticVertexArray_, GL_TRIANGLES);
+                    break;
+                case Mode::Fluid:
+                    fluidEmitter_->renderInstanced(Application::instance().context(), program, fluidVertexArray_, GL_TRIANGLES);
+                    break;
+                }
+            }
 
-            lightProgram_->bind();
-            lightProgram_->setUniform("uProjectionMatrix", camera_->projection());
-            lightProgram_->setUniform("uViewMatrix",       camera_->view());
-            lightProgram_->setUniform("uModelMatrix",      glm::translate(glm::mat4{1.0f}, lightPosition_));
+            if(linked(lightProgram_)) {
+                lightProgram_->bind();
+                lightProgram_->setUniform("uModelMatrix", glm::translate(glm::mat4{1.0f}, lightPosition_));
 
-            lightVertexArray_->bind();
+                lightVertexArray_->bind();
 
-            Application::instance().context().renderIndexed(lightVertexArray_->indexCount(), GL_TRIANGLE_STRIP);
+                Application::instance().context().renderIndexed(lightVertexArray_->indexCount(), lightVertexArray_->indexType(), GL_TRIANGLE_STRIP);
+            }
 
             Application::instance().context().endFrame();
         }
     }
 
+    void ParticleScene::setupPrograms() noexcept
+    {
+        /**** material setup ****/
+        if(modelProgram_ && modelProgram_->status() == ProgramStatus::Linked) {
+            modelProgram_->setUniform("uMaterial.color",     glm::vec4{1.0f, 0.0f, 1.0f, 1.0f});
+            modelProgram_->setUniform("uMaterial.shininess", 32.0f);
+        }
+
+        for(const auto& program : {instancedModelProgram_, computeModelProgram_, analyticModelProgram_})
+            if(program && program->status() == ProgramStatus::Linked)
+                program->setUniform("uMaterial.shininess", 32.0f);
+
+        if(analyticModelProgram_ && analyticModelProgram_->status() == ProgramStatus::Linked)
+            analyticEmitter_->attachProgram(analyticModelProgram_);
+    }
+
     /**** TextureMapScene ****/
     TextureMapScene::TextureMapScene()
     {
@@ -288,124 +646,22 @@ namespace glem {
 
     void TextureMapScene::attach() noexcept
     {
-        const auto& vs = R"glsl(
-                         #version 450
-                         layout(location = 0) in vec3 vPosition;
-                         layout(location = 1) in vec3 vNormal;
-                            uniform mat4 uProjectionMatrix;
-                            uniform mat4 uViewMatrix;
-                            uniform mat4 uModelMatrix = mat4(1.0f);
-                         void main() {
-                            gl_Position = uProjectionMatrix * uViewMatrix * uModelMatrix * vec4(vPosition, 1.0f);
-                         }
-                         )glsl";
-
-        const auto& ps = R"glsl(
-                         #version 450
-                         layout(location = 0) out vec4 FragmentColor;
-                            uniform vec4 uColor = vec4(1.0f, 1.0f, 1.0f, 1.0f);
-                         void main() {
-                            FragmentColor = uColor;
-                         }
-                         )glsl";
+        registerShaderIncludes();
 
-        lightProgram_ = std::make_shared<Program>();
-        lightProgram_->append(std::make_unique<Shader>(vs, ShaderType::VS));
-        lightProgram_->append(std::make_unique<Shader>(ps, ShaderType::PS));
+        lightProgram_ = ProgramLibrary::instance().acquire({{ShaderType::VS, LIGHT_VS}, {ShaderType::PS, LIGHT_PS}});
 
-        if(!lightProgram_->link()) {
+        if(!lightProgram_) {
             Log::e(TAG, "Failed to link light shader program.");
             return;
         }
 
-        const auto& phong_textured_vs = R"glsl(
-                         #version 450
-
-                         layout(location = 0) in vec3 vPosition;
-                         layout(location = 1) in vec3 vNormal;
-                         layout(location = 2) in vec2 vUv;
-
-                         uniform mat4 uProjectionMatrix;
-                         uniform mat4 uViewMatrix;
-                         uniform mat4 uModelMatrix = mat4(1.0f);
-
-                         out vec3 fPosition;
-                         out vec3 fNormal;
-                         out vec2 fUv;
-
-                         void main() {
-                            gl_Position = uProjectionMatrix * uViewMatrix * uModelMatrix * vec4(vPosition, 1.0f);
-
-                            fPosition = vec3(uModelMatrix * vec4(vPosition, 1.0f));
-                            fNormal   = mat3(transpose(inverse(uModelMatrix))) * vNormal;
-                            fUv       = vUv;
-                         }
-
-                         )glsl";
-
-        const auto& phong_textured_ps = R"glsl(
-                         #version 450
-
-                         layout(location = 0) out vec4 FragmentColor;
-
-                         uniform vec3 uViewPosition;
-
-                         struct Material {
-                            sampler2D diffuse;
-                            sampler2D specular;
-
-                            float shininess;
-                         };
-
-                         struct Light {
-                            vec3 position;
-
-                            vec3 ambient;
-                            vec3 diffuse;
-                            vec3 specular;
-
-                            float constant;
-                            float linear;
-                            float quadratic;
-                         };
-
-                         uniform Light uLight;
-                         uniform Material uMaterial;
+        Program phong;
+        phong.append(std::make_unique<Shader>(PHONG_VS, ShaderType::VS));
+        phong.append(std::make_unique<Shader>(PHONG_PS, ShaderType::PS));
 
-                         in vec3 fPosition;
-                         in vec3 fNormal;
-                         in vec2 fUv;
+        modelProgram_ = phong.variant({"TEXTURED"});
 
-                         void main() {
-                            vec3 ambient = uLight.ambient * vec3(texture2D(uMaterial.diffuse, fUv));
-
-                            vec3 N = normalize(fNormal);
-                            vec3 L = normalize(uLight.position - fPosition);
-
-                            vec3 diffuse = uLight.diffuse * max(dot(N, L), 0.0f) * vec3(texture2D(uMaterial.diffuse, fUv));
-
-                            vec3 V = normalize(uViewPosition - fPosition);
-                            vec3 R = reflect(-L, N);
-
-                            vec3 specular = uLight.specular * pow(max(dot(V, R), 0.0f), uMaterial.shininess) * vec3(texture2D(uMaterial.specular, fUv));
-
-                            float D = length(uLight.position - fPosition);
-
-                            float attenuation = 1.0f / (uLight.constant + uLight.linear * D + uLight.quadratic * D * D);
-
-                            ambient  *= attenuation;
-                            diffuse  *= attenuation;
-                            specular *= attenuation;
-
-                            FragmentColor = vec4((ambient + diffuse + specular), 1.0f);
-                         }
-                         )glsl";
-
-        modelProgram_ = std::make_shared<Program>();
-        modelProgram_->append(std::make_unique<Shader>(phong_textured_vs, ShaderType::VS));
-        modelProgram_->append(std::make_unique<Shader>(phong_textured_ps, ShaderType::PS));
-
-        if(!modelProgram_->link()) {
+        if(!modelProgram_) {
             Log::e(TAG, "Failed to link model shader program.");
             return;
         }
@@ -443,14 +699,17 @@ namespace glem {
         modelProgram_->setUniform("uMaterial.specular",  static_cast<int>(specularMap_->settings().unit));
         modelProgram_->setUniform("uMaterial.shininess", 64.0f);
 
-        /**** light setup ****/
-        modelProgram_->setUniform("uLight.position",  lightPosition_);
-        modelProgram_->setUniform("uLight.ambient",   glm::vec3{0.2f, 0.2f, 0.2f});
-        modelProgram_->setUniform("uLight.diffuse",   glm::vec3{0.5f, 0.5f, 0.5f});
-        modelProgram_->setUniform("uLight.specular",  glm::vec3{1.0f, 1.0f, 1.0f});
-        modelProgram_->setUniform("uLight.constant",  1.0f);
-        modelProgram_->setUniform("uLight.linear",    0.09f);
-        modelProgram_->setUniform("uLight.quadratic", 0.032f);
+        /**** camera and light blocks ****/
+        cameraBuffer_ = std::make_unique<UniformBuffer>(cameraLayout());
+
+        lightBuffer_ = std::make_unique<UniformBuffer>(lightLayout());
+        lightBuffer_->set("position",  lightPosition_);
+        lightBuffer_->set("ambient",   glm::vec3{0.2f, 0.2f, 0.2f});
+        lightBuffer_->set("diffuse",   glm::vec3{0.5f, 0.5f, 0.5f});
+        lightBuffer_->set("specular",  glm::vec3{1.0f, 1.0f, 1.0f});
+        lightBuffer_->set("constant",  1.0f);
+        lightBuffer_->set("linear",    0.09f);
+        lightBuffer_->set("quadratic", 0.032f);
 
         const auto projection = glm::perspective(glm::radians(45.0f),
                                                  static_cast<float>(glem::Application::instance().window().width()) / static_cast<float>(glem::Application::instance().window().height()),
@@ -461,14 +720,14 @@ namespace glem {
         camera_->setPosition({0.0f, 0.0f, 5.0f});
         camera_->setProjection(projection);
 
-        /**** init vertex arrays ****/
+        /**** init meshes ****/
+        meshes_ = std::make_unique<MeshArena>();
+
         auto cube = Shape::texturedCube();
 
         cube.setFlat();
 
-        modelVertexArray_ = std::make_shared<VertexArray>();
-        modelVertexArray_->append(std::make_unique<VertexBuffer>(cube.buffer));
-        modelVertexArray_->append(std::make_unique<IndexBuffer>(cube.indices));
+        modelMesh_ = meshes_->append(cube).value_or(MeshHandle{});
 
         auto sphere = Shape::sphere({12, 12});
 
@@ -478,9 +737,7 @@ namespace glem {
         sphereVertexLayout.push<ElementType::Vector3f>("position");
         sphereVertexLayout.push<ElementType::Vector3f>("normal");
 
-        lightVertexArray_ = std::make_shared<VertexArray>();
-        lightVertexArray_->append(std::make_unique<VertexBuffer>(sphere.buffer));
-        lightVertexArray_->append(std::make_unique<IndexBuffer>(sphere.indices));
+        lightMesh_ = meshes_->append(sphere).value_or(MeshHandle{});
 
         glEnable(GL_CULL_FACE);
         glEnable(GL_DEPTH_TEST);
@@ -535,27 +792,27 @@ namespace glem {
         if(visible()) {
             Application::instance().context().beginFrame({0.1f, 0.1f, 0.1f, 1.0f});
 
+            cameraBuffer_->set("uProjectionMatrix", camera_->projection());
+            cameraBuffer_->set("uViewMatrix",       camera_->view());
+            cameraBuffer_->set("uViewPosition",     camera_->position());
+            cameraBuffer_->update();
+            cameraBuffer_->bindBase(CAMERA_BINDING);
+
+            lightBuffer_->set("position", lightPosition_);
+            lightBuffer_->update();
+            lightBuffer_->bindBase(LIGHT_BINDING);
+
             modelProgram_->bind();
-            modelProgram_->setUniform("uProjectionMatrix", camera_->projection());
-            modelProgram_->setUniform("uViewMatrix",       camera_->view());
-            modelProgram_->setUniform("uViewPosition",     camera_->position());
-            modelProgram_->setUniform("uLight.position",   lightPosition_);
 
             diffuseMap_->bind();
             specularMap_->bind();
 
-            modelVertexArray_->bind();
-
-            Application::instance().context().renderIndexed(modelVertexArray_->indexCount(), GL_TRIANGLES);
+            meshes_->render(Application::instance().context(), modelMesh_, GL_TRIANGLES);
 
             lightProgram_->bind();
-            lightProgram_->setUniform("uProjectionMatrix", camera_->projection());
-            lightProgram_->setUniform("uViewMatrix",       camera_->view());
-            lightProgram_->setUniform("uModelMatrix",      glm::translate(glm::mat4{1.0f}, lightPosition_));
+            lightProgram_->setUniform("uModelMatrix", glm::translate(glm::mat4{1.0f}, lightPosition_));
 
-            lightVertexArray_->bind();
-
-            Application::instance().context().renderIndexed(lightVertexArray_->indexCount(), GL_TRIANGLE_STRIP);
+            meshes_->render(Application::instance().context(), lightMesh_, GL_TRIANGLE_STRIP);
 
             Application::instance().context().endFrame();
         }
@@ -574,14 +831,15 @@ namespace glem {
 
     void SkyboxScene::attach() noexcept
     {
+        registerShaderIncludes();
+
         const auto& vs = R"glsl(
                          #version 450
                          layout(location = 0) in vec3 vPosition;
-                            uniform mat4 uProjectionMatrix;
-                            uniform mat4 uViewMatrix;
+                            #include "camera.glsl"
                             out vec3 fUv;
                          void main() {
-                            gl_Position = uProjectionMatrix * uViewMatrix * vec4(vPosition, 1.0f);
+                            gl_Position = uProjectionMatrix * mat4(mat3(uViewMatrix)) * vec4(vPosition, 1.0f);
                             fUv         = vPosition;
                          }
                          )glsl";
@@ -596,11 +854,9 @@ namespace glem {
                          }
                          )glsl";
 
-        program_ = std::make_shared<Program>();
-        program_->append(std::make_unique<Shader>(vs, ShaderType::VS));
-        program_->append(std::make_unique<Shader>(ps, ShaderType::PS));
+        program_ = ProgramLibrary::instance().acquire({{ShaderType::VS, vs}, {ShaderType::PS, ps}});
 
-        if(!program_->link()) {
+        if(!program_) {
             Log::e(TAG, "Failed to link skybox shader program.");
             return;
         }
@@ -614,6 +870,8 @@ namespace glem {
         camera_->setPosition({0.0f, 0.0f, 0.0f});
         camera_->setProjection(projection);
 
+        cameraBuffer_ = std::make_unique<UniformBuffer>(cameraLayout());
+
         std::array<const char*, 6> faces {
             "skybox/posx.jpg",
             "skybox/negx.jpg",
@@ -674,14 +932,19 @@ namespace glem {
 
             glDepthFunc(GL_LEQUAL);
 
+            /**** translation is stripped from view in shader ****/
+            cameraBuffer_->set("uProjectionMatrix", camera_->projection());
+            cameraBuffer_->set("uViewMatrix",       camera_->view());
+            cameraBuffer_->set("uViewPosition",     camera_->position());
+            cameraBuffer_->update();
+            cameraBuffer_->bindBase(CAMERA_BINDING);
+
             program_->bind();
-            program_->setUniform("uProjectionMatrix", camera_->projection());
-            program_->setUniform("uViewMatrix",       glm::mat4{glm::mat3{camera_->view()}});
 
             cubemap_->bind();
             vertexArray_->bind();
 
-            Application::instance().context().renderIndexed(vertexArray_->indexCount(), GL_TRIANGLES);
+            Application::instance().context().renderIndexed(vertexArray_->indexCount(), vertexArray_->indexType(), GL_TRIANGLES);
 
             glDepthFunc(GL_LESS);
 
@@ -724,12 +987,9 @@ namespace glem {
                          }
                          )glsl";
 
-        program_ = std::make_shared<Program>();
-
-        program_->append(std::make_unique<Shader>(vs, ShaderType::VS));
-        program_->append(std::make_unique<Shader>(ps, ShaderType::PS));
+        program_ = ProgramLibrary::instance().acquire({{ShaderType::VS, vs}, {ShaderType::PS, ps}});
 
-        if(!program_->link()) {
+        if(!program_) {
             Log::e(TAG, "Failed to link skybox shader program.");
             return;
         }
@@ -790,7 +1050,7 @@ namespace glem {
             model_->bind();
 
             Application::instance().context().beginFrame({0.1f, 0.1f, 0.1f, 1.0f});
-            Application::instance().context().renderIndexed(model_->indexCount(), GL_TRIANGLE_STRIP);
+            Application::instance().context().renderIndexed(model_->indexCount(), model_->indexType(), GL_TRIANGLE_STRIP);
             Application::instance().context().endFrame();
         }
     }
@@ -8,6 +8,8 @@
 #include <glm/gtc/constants.hpp>
 #include <glm/gtx/compatibility.hpp>
 
+#include "MeshArena.hpp"
+
 namespace glem {
 
     class Scene {
@@ -50,8 +52,13 @@ namespace glem {
 
     class Camera;
     class Program;
+    class ProgramBatch;
     class VertexArray;
+    class UniformBuffer;
+    class ThreadPool;
     class ParticleEmitter;
+    class ComputeParticleEmitter;
+    class AnalyticParticleEmitter;
 
     class ParticleScene : public Scene {
     public:
@@ -65,16 +72,45 @@ namespace glem {
         void render() noexcept override;
 
     private:
-        std::unique_ptr<Camera>          camera_  {nullptr};
-        std::unique_ptr<ParticleEmitter> emitter_ {nullptr};
+        enum class Mode {
+            Instanced,
+            PerParticle,
+            Compute,
+            Analytic,
+            Fluid
+        };
 
-        std::shared_ptr<Program> lightProgram_ {nullptr};
-        std::shared_ptr<Program> modelProgram_ {nullptr};
+        /**
+         * @brief Set material uniforms and attach programs, called once batch finished linking
+         */
+        void setupPrograms() noexcept;
+
+        std::unique_ptr<Camera>                  camera_          {nullptr};
+        std::unique_ptr<ThreadPool>              threads_         {nullptr};
+        std::unique_ptr<ParticleEmitter>         emitter_         {nullptr};
+        std::unique_ptr<ParticleEmitter>         fluidEmitter_    {nullptr};
+        std::unique_ptr<ComputeParticleEmitter>  computeEmitter_  {nullptr};
+        std::unique_ptr<AnalyticParticleEmitter> analyticEmitter_ {nullptr};
+
+        std::shared_ptr<Program> lightProgram_          {nullptr};
+        std::shared_ptr<Program> modelProgram_          {nullptr};
+        std::shared_ptr<Program> instancedModelProgram_ {nullptr};
+        std::shared_ptr<Program> computeModelProgram_   {nullptr};
+        std::shared_ptr<Program> analyticModelProgram_  {nullptr};
 
-        std::shared_ptr<VertexArray> lightVertexArray_ {nullptr};
-        std::shared_ptr<VertexArray> modelVertexArray_ {nullptr};
+        std::unique_ptr<ProgramBatch> batch_ {nullptr};
+
+        std::shared_ptr<VertexArray> lightVertexArray_    {nullptr};
+        std::shared_ptr<VertexArray> modelVertexArray_    {nullptr};
+        std::shared_ptr<VertexArray> analyticVertexArray_ {nullptr};
+        std::shared_ptr<VertexArray> fluidVertexArray_    {nullptr};
+
+        std::unique_ptr<UniformBuffer> cameraBuffer_ {nullptr};
+        std::unique_ptr<UniformBuffer> lightBuffer_  {nullptr};
 
         glm::vec3 lightPosition_ {0.0f, 0.0f, 0.0f};
+
+        Mode mode_ {Mode::Instanced};
     };
 
     class Texture;
@@ -96,12 +132,17 @@ namespace glem {
         std::shared_ptr<Program> lightProgram_ {nullptr};
         std::shared_ptr<Program> modelProgram_ {nullptr};
 
-        std::shared_ptr<VertexArray> lightVertexArray_ {nullptr};
-        std::shared_ptr<VertexArray> modelVertexArray_ {nullptr};
+        std::unique_ptr<MeshArena> meshes_ {nullptr};
+
+        MeshHandle lightMesh_;
+        MeshHandle modelMesh_;
 
         std::unique_ptr<Texture> diffuseMap_  {nullptr};
         std::unique_ptr<Texture> specularMap_ {nullptr};
 
+        std::unique_ptr<UniformBuffer> cameraBuffer_ {nullptr};
+        std::unique_ptr<UniformBuffer> lightBuffer_  {nullptr};
+
         glm::vec3 lightPosition_ {1.2f, 1.0f, 2.0f};
     };
 
@@ -124,6 +165,8 @@ namespace glem {
         std::shared_ptr<Program>     program_     {nullptr};
         std::unique_ptr<Cubemap>     cubemap_     {nullptr};
         std::shared_ptr<VertexArray> vertexArray_ {nullptr};
+
+        std::unique_ptr<UniformBuffer> cameraBuffer_ {nullptr};
     };
 
     class DynamicVertexSystemTest : public Scene {
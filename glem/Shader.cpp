@@ -1,6 +1,9 @@
 #include "Shader.hpp"
 
 #include "Log.hpp"
+#include "ShaderPreprocessor.hpp"
+
+#include <cstring>
 
 #include <glad/glad.h>
 
@@ -18,10 +21,50 @@ namespace glem {
         static constexpr size_t type = GL_FRAGMENT_SHADER;
     };
 
-    Shader::Shader(const std::string &source, ShaderType type) :
-        type_{type}
+    template<> struct ShaderTypeMap<ShaderType::CS> {
+        static constexpr size_t type = GL_COMPUTE_SHADER;
+    };
+
+    template<> struct ShaderTypeMap<ShaderType::GS> {
+        static constexpr size_t type = GL_GEOMETRY_SHADER;
+    };
+
+    template<> struct ShaderTypeMap<ShaderType::TCS> {
+        static constexpr size_t type = GL_TESS_CONTROL_SHADER;
+    };
+
+    template<> struct ShaderTypeMap<ShaderType::TES> {
+        static constexpr size_t type = GL_TESS_EVALUATION_SHADER;
+    };
+
+    namespace {
+        /**
+         * @brief GL_KHR_parallel_shader_compile tokens, same values in ARB variant
+         */
+        static constexpr const GLenum MAX_SHADER_COMPILER_THREADS = 0x91B0;
+        static constexpr const GLenum COMPLETION_STATUS           = 0x91B1;
+
+        using MaxShaderCompilerThreadsProc = void (APIENTRYP)(GLuint count);
+
+        bool parallel {false};
+
+        bool extensionSupported(const char* name) noexcept {
+            int count {0};
+
+            glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+            for(int i = 0; i < count; ++i)
+                if(std::strcmp(reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i))), name) == 0)
+                    return true;
+
+            return false;
+        }
+    }
+
+    Shader::Shader(const std::string &source, ShaderType type, const std::vector<std::string> &defines) :
+        source_{source}, defines_{defines}, type_{type}
     {
-        handler_ = compile(source, type_);
+        code_ = ShaderPreprocessor::instance().process(source_, defines_);
     }
 
     Shader::~Shader()
@@ -29,51 +72,127 @@ namespace glem {
         glDeleteShader(handler_);
     }
 
-    uint32_t Shader::handler() const noexcept
+    bool Shader::enableParallelCompile(ProcLoader loader) noexcept
     {
-        return handler_;
+        const char* entry = nullptr;
+
+        if(extensionSupported("GL_KHR_parallel_shader_compile"))
+            entry = "glMaxShaderCompilerThreadsKHR";
+        else if(extensionSupported("GL_ARB_parallel_shader_compile"))
+            entry = "glMaxShaderCompilerThreadsARB";
+
+        if(!entry) {
+            parallel = false;
+            return false;
+        }
+
+        /**** let driver pick thread count, default may be serial on some drivers ****/
+        if(auto maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(loader(entry)))
+            maxShaderCompilerThreads(0xFFFFFFFFu);
+
+        parallel = true;
+
+        return true;
     }
 
-    uint32_t Shader::compile(const std::string &src, ShaderType type) noexcept
+    bool Shader::parallelCompile() noexcept
     {
-        uint32_t shader{0u};
+        return parallel;
+    }
 
-        switch (type) {
+    void Shader::submit() noexcept
+    {
+        if(handler_ != 0u)
+            return;
+
+        switch (type_) {
         case ShaderType::VS:
-            shader = glCreateShader(ShaderTypeMap<ShaderType::VS>::type);
+            handler_ = glCreateShader(ShaderTypeMap<ShaderType::VS>::type);
             break;
         case ShaderType::PS:
-            shader = glCreateShader(ShaderTypeMap<ShaderType::PS>::type);
+            handler_ = glCreateShader(ShaderTypeMap<ShaderType::PS>::type);
+            break;
+        case ShaderType::CS:
+            handler_ = glCreateShader(ShaderTypeMap<ShaderType::CS>::type);
+            break;
+        case ShaderType::GS:
+            handler_ = glCreateShader(ShaderTypeMap<ShaderType::GS>::type);
+            break;
+        case ShaderType::TCS:
+            handler_ = glCreateShader(ShaderTypeMap<ShaderType::TCS>::type);
+            break;
+        case ShaderType::TES:
+            handler_ = glCreateShader(ShaderTypeMap<ShaderType::TES>::type);
             break;
         }
 
-        auto csrc   = src.c_str();
+        auto csrc = code_.c_str();
+
+        glShaderSource(handler_, 1, &csrc, nullptr);
+
+        glCompileShader(handler_);
+    }
+
+    bool Shader::ready() const noexcept
+    {
+        if(!parallel || handler_ == 0u)
+            return true;
 
-        glShaderSource(shader, 1, &csrc, nullptr);
+        int ret {GL_TRUE};
 
-        glCompileShader(shader);
+        glGetShaderiv(handler_, COMPLETION_STATUS, &ret);
+
+        return ret == GL_TRUE;
+    }
+
+    bool Shader::compile() noexcept
+    {
+        submit();
 
         int ret {GL_FALSE};
 
-        glGetShaderiv(shader, GL_COMPILE_STATUS, &ret);
+        glGetShaderiv(handler_, GL_COMPILE_STATUS, &ret);
 
         if(ret == GL_FALSE) {
             int length {0};
 
-            glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+            glGetShaderiv(handler_, GL_INFO_LOG_LENGTH, &length);
 
             std::string msg(std::size_t(length), ' ');
 
-            glGetShaderInfoLog(shader, length, &length, msg.data());
+            glGetShaderInfoLog(handler_, length, &length, msg.data());
 
-            glem::Log::e(TAG, "Unable to compile shader: ", msg, src);
+            glem::Log::e(TAG, "Unable to compile shader: ", msg, code_);
 
-            glDeleteShader(shader);
-
-            return 0u;
+            return false;
         }
 
-        return shader;
+        return true;
+    }
+
+    uint32_t Shader::handler() const noexcept
+    {
+        return handler_;
+    }
+
+    const std::string &Shader::source() const noexcept
+    {
+        return source_;
+    }
+
+    const std::string &Shader::code() const noexcept
+    {
+        return code_;
+    }
+
+    const std::vector<std::string> &Shader::defines() const noexcept
+    {
+        return defines_;
+    }
+
+    ShaderType Shader::type() const noexcept
+    {
+        return type_;
     }
 
 }
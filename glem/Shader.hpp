@@ -3,19 +3,44 @@
 #include "Bindable.hpp"
 
 #include <string>
+#include <vector>
 
 namespace glem {
 
+    /**
+     * @brief Program stages, values are part of program cache keys so new ones go last
+     */
     enum class ShaderType {
         VS,
-        PS
+        PS,
+        CS,
+        GS,
+        TCS,
+        TES
     };
 
     template<ShaderType> struct ShaderTypeMap;
 
+    /**
+     * @brief Program stage source
+     */
+    struct ShaderStage {
+        ShaderType type;
+
+        std::string source;
+    };
+
     class Shader {
     public:
-        Shader(const std::string& source, ShaderType type);
+        using ProcLoader = void* (*)(const char*);
+
+        /**
+         * @brief Shader, source is preprocessed immediately but compiled on program link
+         * @param source  - GLSL source, may contain #include directives
+         * @param type    - stage
+         * @param defines - "NAME" or "NAME value", inserted after #version
+         */
+        Shader(const std::string& source, ShaderType type, const std::vector<std::string>& defines = {});
         ~Shader();
 
         Shader(Shader&&) = delete;
@@ -25,16 +50,77 @@ namespace glem {
         Shader& operator=(const Shader&) = delete;
 
         /**
-         * @brief Shader handler
+         * @brief Enable driver side parallel compilation if GL_KHR_parallel_shader_compile
+         *        or GL_ARB_parallel_shader_compile is exposed, requires current context
+         * @param loader - GL function loader, extension isn't part of generated glad
+         * @return
+         */
+        static bool enableParallelCompile(ProcLoader loader) noexcept;
+
+        /**
+         * @brief Check if completion status may be polled without blocking
+         * @return
+         */
+        static bool parallelCompile() noexcept;
+
+        /**
+         * @brief Issue compilation without waiting for result, does nothing if already issued
+         *
+         * Compilation is deferred until program link so programs restored from
+         * binary cache never touch shader compiler.
+         */
+        void submit() noexcept;
+
+        /**
+         * @brief Check if compilation finished, always true without parallel compile support
+         * @return
+         */
+        bool ready() const noexcept;
+
+        /**
+         * @brief Compile shader and check result, blocks until compilation finished
+         * @return
+         */
+        bool compile() noexcept;
+
+        /**
+         * @brief Shader handler, 0 until compiled
          * @return
          */
         uint32_t handler() const noexcept;
 
-    private:
-        uint32_t compile(const std::string& src, ShaderType type) noexcept;
+        /**
+         * @brief Shader source as given, before preprocessing
+         * @return
+         */
+        const std::string& source() const noexcept;
+
+        /**
+         * @brief Preprocessed source handed to compiler
+         * @return
+         */
+        const std::string& code() const noexcept;
 
+        /**
+         * @brief Defines shader was preprocessed with
+         * @return
+         */
+        const std::vector<std::string>& defines() const noexcept;
+
+        /**
+         * @brief Shader type
+         * @return
+         */
+        ShaderType type() const noexcept;
+
+    private:
         uint32_t handler_{0u};
 
+        std::string source_;
+        std::string code_;
+
+        std::vector<std::string> defines_;
+
         ShaderType type_;
 
     };
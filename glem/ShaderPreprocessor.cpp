@@ -0,0 +1,153 @@
+#include "ShaderPreprocessor.hpp"
+
+#include "Log.hpp"
+
+#include <fstream>
+#include <sstream>
+
+namespace {
+    static constexpr const char* TAG = "ShaderPreprocessor";
+
+    static constexpr const uint32_t MAX_DEPTH = 16u;
+
+    inline std::string_view trim(std::string_view value) noexcept {
+        const auto begin = value.find_first_not_of(" \t\r");
+
+        if(begin == std::string_view::npos)
+            return {};
+
+        return value.substr(begin, value.find_last_not_of(" \t\r") - begin + 1);
+    }
+
+    /**
+     * @brief Extract name from #include "name" or #include <name>
+     */
+    inline bool parseInclude(std::string_view line, std::string& name) noexcept {
+        static constexpr std::string_view DIRECTIVE = "#include";
+
+        if(line.substr(0, DIRECTIVE.size()) != DIRECTIVE)
+            return false;
+
+        const auto rest  = trim(line.substr(DIRECTIVE.size()));
+
+        if(rest.size() < 2u || !((rest.front() == '"' && rest.back() == '"') || (rest.front() == '<' && rest.back() == '>')))
+            return false;
+
+        name = rest.substr(1, rest.size() - 2);
+
+        return true;
+    }
+}
+
+namespace glem {
+
+    ShaderPreprocessor &ShaderPreprocessor::instance() noexcept
+    {
+        static ShaderPreprocessor preprocessor;
+
+        return preprocessor;
+    }
+
+    void ShaderPreprocessor::add(const std::string &name, const std::string &source) noexcept
+    {
+        sources_[name] = source;
+    }
+
+    std::string ShaderPreprocessor::process(const std::string &source, const std::vector<std::string> &defines) const noexcept
+    {
+        std::string directives;
+
+        for(const auto& define : defines)
+            directives += "#define " + define + "\n";
+
+        /**** #version has to stay first, defines and includes go right after it ****/
+        std::string head;
+        std::string body = source;
+
+        uint32_t line {1u};
+
+        if(const auto version = source.find("#version"); version != std::string::npos) {
+            auto end = source.find('\n', version);
+
+            end = end == std::string::npos ? source.size() : end + 1;
+
+            head = source.substr(0, end);
+            body = source.substr(end);
+
+            for(auto c : head)
+                if(c == '\n')
+                    ++line;
+
+            if(head.back() != '\n')
+                head += '\n';
+        }
+
+        std::string output = head + directives + "#line " + std::to_string(line) + " 0\n";
+
+        Context context;
+
+        expand(body, 0u, line, output, context, 0u);
+
+        return output;
+    }
+
+    void ShaderPreprocessor::expand(const std::string &source, uint32_t string, uint32_t first, std::string &output, Context &context, uint32_t depth) const noexcept
+    {
+        std::istringstream stream(source);
+        std::string        current;
+        std::string        name;
+
+        auto line = first;
+
+        for(; std::getline(stream, current); ++line) {
+            if(!parseInclude(trim(current), name)) {
+                output += current;
+                output += '\n';
+                continue;
+            }
+
+            if(context.included.count(name)) {
+                output += '\n';
+                continue;
+            }
+
+            if(depth >= MAX_DEPTH) {
+                Log::e(TAG, "Include depth exceeded at ", name);
+                output += '\n';
+                continue;
+            }
+
+            const auto included = load(name);
+
+            context.included.insert(name);
+
+            const auto number = ++context.strings;
+
+            output += "#line 1 " + std::to_string(number) + "\n";
+
+            expand(included, number, 1u, output, context, depth + 1u);
+
+            output += "#line " + std::to_string(line + 1u) + " " + std::to_string(string) + "\n";
+        }
+    }
+
+    std::string ShaderPreprocessor::load(const std::string &name) const noexcept
+    {
+        if(auto it = sources_.find(name); it != sources_.end())
+            return it->second;
+
+        std::ifstream file(name);
+
+        if(!file.is_open()) {
+            Log::e(TAG, "Unable to resolve include ", name);
+            return {};
+        }
+
+        std::stringstream ss;
+
+        ss << file.rdbuf();
+
+        return ss.str();
+    }
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace glem {
+
+    /**
+     * @brief GLSL source preprocessor resolving #include "name" and injecting defines
+     *
+     * Includes are looked up among registered sources first, then on disk relative
+     * to working directory. Every source is included at most once per shader, so
+     * shared declarations don't need guards. #line directives keep compiler messages
+     * pointing at original lines, included sources get string numbers in include order.
+     */
+    class ShaderPreprocessor {
+    public:
+        ShaderPreprocessor(ShaderPreprocessor&&) = delete;
+        ShaderPreprocessor(const ShaderPreprocessor&) = delete;
+
+        ShaderPreprocessor& operator=(ShaderPreprocessor&&) = delete;
+        ShaderPreprocessor& operator=(const ShaderPreprocessor&) = delete;
+
+        /**
+         * @brief Preprocessor instance
+         * @return
+         */
+        static ShaderPreprocessor& instance() noexcept;
+
+        /**
+         * @brief Register include source, replaces existing one
+         * @param name   - name used in #include directive
+         * @param source - GLSL source without #version
+         */
+        void add(const std::string& name, const std::string& source) noexcept;
+
+        /**
+         * @brief Resolve includes and insert defines right after #version
+         * @param source
+         * @param defines - "NAME" or "NAME value"
+         * @return
+         */
+        std::string process(const std::string& source, const std::vector<std::string>& defines) const noexcept;
+
+    private:
+        ShaderPreprocessor() = default;
+        ~ShaderPreprocessor() = default;
+
+        struct Context {
+            std::unordered_set<std::string> included;
+
+            uint32_t strings {0u};
+        };
+
+        /**
+         * @brief Copy source to output replacing include directives
+         * @param source
+         * @param string - source string number for #line
+         * @param first  - line number of first source line
+         * @param output
+         * @param context
+         * @param depth  - include nesting
+         */
+        void expand(const std::string& source, uint32_t string, uint32_t first, std::string& output, Context& context, uint32_t depth) const noexcept;
+
+        std::string load(const std::string& name) const noexcept;
+
+        std::unordered_map<std::string, std::string> sources_;
+
+    };
+
+}
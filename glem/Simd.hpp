@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GLEM_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace glem::simd {
+
+#if defined(__AVX2__)
+    static constexpr const size_t WIDTH = 8u;
+
+    struct Float {
+        __m256 value;
+    };
+
+    inline Float load(const float* ptr) noexcept { return {_mm256_loadu_ps(ptr)}; }
+    inline void store(float* ptr, Float v) noexcept { _mm256_storeu_ps(ptr, v.value); }
+    inline Float set(float v) noexcept { return {_mm256_set1_ps(v)}; }
+
+    inline Float operator+(Float a, Float b) noexcept { return {_mm256_add_ps(a.value, b.value)}; }
+    inline Float operator-(Float a, Float b) noexcept { return {_mm256_sub_ps(a.value, b.value)}; }
+    inline Float operator*(Float a, Float b) noexcept { return {_mm256_mul_ps(a.value, b.value)}; }
+    inline Float operator/(Float a, Float b) noexcept { return {_mm256_div_ps(a.value, b.value)}; }
+
+    inline Float min(Float a, Float b) noexcept { return {_mm256_min_ps(a.value, b.value)}; }
+    inline Float max(Float a, Float b) noexcept { return {_mm256_max_ps(a.value, b.value)}; }
+    inline Float sqrt(Float a) noexcept { return {_mm256_sqrt_ps(a.value)}; }
+    inline Float floor(Float a) noexcept { return {_mm256_floor_ps(a.value)}; }
+
+    struct Mask {
+        __m256 value;
+    };
+
+    inline Mask operator<(Float a, Float b) noexcept { return {_mm256_cmp_ps(a.value, b.value, _CMP_LT_OQ)}; }
+    inline Mask operator<=(Float a, Float b) noexcept { return {_mm256_cmp_ps(a.value, b.value, _CMP_LE_OQ)}; }
+    inline Mask operator>(Float a, Float b) noexcept { return {_mm256_cmp_ps(a.value, b.value, _CMP_GT_OQ)}; }
+    inline Mask operator>=(Float a, Float b) noexcept { return {_mm256_cmp_ps(a.value, b.value, _CMP_GE_OQ)}; }
+
+    inline Mask operator&(Mask a, Mask b) noexcept { return {_mm256_and_ps(a.value, b.value)}; }
+    inline Mask operator|(Mask a, Mask b) noexcept { return {_mm256_or_ps(a.value, b.value)}; }
+    inline Mask operator!(Mask a) noexcept { return {_mm256_xor_ps(a.value, _mm256_castsi256_ps(_mm256_set1_epi32(-1)))}; }
+
+    /**
+     * @brief Per lane mask ? a : b
+     */
+    inline Float select(Mask mask, Float a, Float b) noexcept { return {_mm256_blendv_ps(b.value, a.value, mask.value)}; }
+    inline bool any(Mask mask) noexcept { return _mm256_movemask_ps(mask.value) != 0; }
+#elif defined(GLEM_SIMD_SSE2)
+    static constexpr const size_t WIDTH = 4u;
+
+    struct Float {
+        __m128 value;
+    };
+
+    inline Float load(const float* ptr) noexcept { return {_mm_loadu_ps(ptr)}; }
+    inline void store(float* ptr, Float v) noexcept { _mm_storeu_ps(ptr, v.value); }
+    inline Float set(float v) noexcept { return {_mm_set1_ps(v)}; }
+
+    inline Float operator+(Float a, Float b) noexcept { return {_mm_add_ps(a.value, b.value)}; }
+    inline Float operator-(Float a, Float b) noexcept { return {_mm_sub_ps(a.value, b.value)}; }
+    inline Float operator*(Float a, Float b) noexcept { return {_mm_mul_ps(a.value, b.value)}; }
+    inline Float operator/(Float a, Float b) noexcept { return {_mm_div_ps(a.value, b.value)}; }
+
+    inline Float min(Float a, Float b) noexcept { return {_mm_min_ps(a.value, b.value)}; }
+    inline Float max(Float a, Float b) noexcept { return {_mm_max_ps(a.value, b.value)}; }
+    inline Float sqrt(Float a) noexcept { return {_mm_sqrt_ps(a.value)}; }
+
+    /**
+     * @brief Floor by truncation, SSE2 has no rounding, valid for |a| < 2^31
+     */
+    inline Float floor(Float a) noexcept {
+        const auto t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.value));
+
+        return {_mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a.value), _mm_set1_ps(1.0f)))};
+    }
+
+    struct Mask {
+        __m128 value;
+    };
+
+    inline Mask operator<(Float a, Float b) noexcept { return {_mm_cmplt_ps(a.value, b.value)}; }
+    inline Mask operator<=(Float a, Float b) noexcept { return {_mm_cmple_ps(a.value, b.value)}; }
+    inline Mask operator>(Float a, Float b) noexcept { return {_mm_cmpgt_ps(a.value, b.value)}; }
+    inline Mask operator>=(Float a, Float b) noexcept { return {_mm_cmpge_ps(a.value, b.value)}; }
+
+    inline Mask operator&(Mask a, Mask b) noexcept { return {_mm_and_ps(a.value, b.value)}; }
+    inline Mask operator|(Mask a, Mask b) noexcept { return {_mm_or_ps(a.value, b.value)}; }
+    inline Mask operator!(Mask a) noexcept { return {_mm_xor_ps(a.value, _mm_castsi128_ps(_mm_set1_epi32(-1)))}; }
+
+    /**
+     * @brief Per lane mask ? a : b
+     */
+    inline Float select(Mask mask, Float a, Float b) noexcept { return {_mm_or_ps(_mm_and_ps(mask.value, a.value), _mm_andnot_ps(mask.value, b.value))}; }
+    inline bool any(Mask mask) noexcept { return _mm_movemask_ps(mask.value) != 0; }
+#else
+    static constexpr const size_t WIDTH = 1u;
+
+    struct Float {
+        float value;
+    };
+
+    inline Float load(const float* ptr) noexcept { return {*ptr}; }
+    inline void store(float* ptr, Float v) noexcept { *ptr = v.value; }
+    inline Float set(float v) noexcept { return {v}; }
+
+    inline Float operator+(Float a, Float b) noexcept { return {a.value + b.value}; }
+    inline Float operator-(Float a, Float b) noexcept { return {a.value - b.value}; }
+    inline Float operator*(Float a, Float b) noexcept { return {a.value * b.value}; }
+    inline Float operator/(Float a, Float b) noexcept { return {a.value / b.value}; }
+
+    inline Float min(Float a, Float b) noexcept { return {a.value < b.value ? a.value : b.value}; }
+    inline Float max(Float a, Float b) noexcept { return {a.value > b.value ? a.value : b.value}; }
+    inline Float sqrt(Float a) noexcept { return {std::sqrt(a.value)}; }
+    inline Float floor(Float a) noexcept { return {std::floor(a.value)}; }
+
+    struct Mask {
+        bool value;
+    };
+
+    inline Mask operator<(Float a, Float b) noexcept { return {a.value < b.value}; }
+    inline Mask operator<=(Float a, Float b) noexcept { return {a.value <= b.value}; }
+    inline Mask operator>(Float a, Float b) noexcept { return {a.value > b.value}; }
+    inline Mask operator>=(Float a, Float b) noexcept { return {a.value >= b.value}; }
+
+    inline Mask operator&(Mask a, Mask b) noexcept { return {a.value && b.value}; }
+    inline Mask operator|(Mask a, Mask b) noexcept { return {a.value || b.value}; }
+    inline Mask operator!(Mask a) noexcept { return {!a.value}; }
+
+    /**
+     * @brief Per lane mask ? a : b
+     */
+    inline Float select(Mask mask, Float a, Float b) noexcept { return mask.value ? a : b; }
+    inline bool any(Mask mask) noexcept { return mask.value; }
+#endif
+
+    /**
+     * @brief Name of compiled instruction set
+     * @return
+     */
+    inline constexpr const char* name() noexcept {
+#if defined(__AVX2__)
+        return "AVX2";
+#elif defined(GLEM_SIMD_SSE2)
+        return "SSE2";
+#else
+        return "Scalar";
+#endif
+    }
+
+}
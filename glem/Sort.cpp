@@ -0,0 +1,83 @@
+#include "Sort.hpp"
+
+#include <array>
+#include <cstring>
+#include <utility>
+
+namespace {
+    static constexpr const uint32_t RADIX_BITS    = 11u;
+    static constexpr const uint32_t RADIX_BUCKETS = 1u << RADIX_BITS;
+    static constexpr const uint32_t RADIX_MASK    = RADIX_BUCKETS - 1u;
+    static constexpr const uint32_t RADIX_PASSES  = 3u;
+
+    /**
+     * @brief Map float bits to unsigned so integer order matches float order
+     */
+    inline uint32_t flip(float value) noexcept {
+        uint32_t bits;
+
+        std::memcpy(&bits, &value, sizeof (bits));
+
+        const uint32_t mask = static_cast<uint32_t>(-static_cast<int32_t>(bits >> 31)) | 0x80000000u;
+
+        return bits ^ mask;
+    }
+}
+
+namespace glem {
+
+    const std::vector<uint32_t> &RadixSort::sort(const float *keys, size_t count) noexcept
+    {
+        keys_.resize(count);
+        swapKeys_.resize(count);
+
+        indices_.resize(count);
+        swapIndices_.resize(count);
+
+        std::array<std::array<uint32_t, RADIX_BUCKETS>, RADIX_PASSES> histograms {};
+
+        /**** build all histograms in one pass ****/
+        for(size_t i = 0; i < count; ++i) {
+            const auto key = flip(keys[i]);
+
+            keys_[i]    = key;
+            indices_[i] = static_cast<uint32_t>(i);
+
+            for(uint32_t pass = 0; pass < RADIX_PASSES; ++pass)
+                ++histograms[pass][(key >> (pass * RADIX_BITS)) & RADIX_MASK];
+        }
+
+        for(uint32_t pass = 0; pass < RADIX_PASSES; ++pass) {
+            auto& histogram = histograms[pass];
+
+            const auto shift = pass * RADIX_BITS;
+
+            /**** all keys share the digit, pass is a no-op ****/
+            if(count == 0u || histogram[(keys_[0] >> shift) & RADIX_MASK] == count)
+                continue;
+
+            uint32_t offset {0u};
+
+            for(auto& bucket : histogram) {
+                const auto size = bucket;
+
+                bucket  = offset;
+                offset += size;
+            }
+
+            for(size_t i = 0; i < count; ++i) {
+                const auto key = keys_[i];
+                const auto dst = histogram[(key >> shift) & RADIX_MASK]++;
+
+                swapKeys_[dst]    = key;
+                swapIndices_[dst] = indices_[i];
+            }
+
+            std::swap(keys_,    swapKeys_);
+            std::swap(indices_, swapIndices_);
+        }
+
+        return indices_;
+    }
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace glem {
+
+    /**
+     * @brief LSD radix sort of float keys, 3 passes of 11 bits
+     *
+     * Sorts indices rather than keys, scratch buffers grow to largest
+     * sorted range and are reused between calls.
+     */
+    class RadixSort {
+    public:
+        RadixSort() = default;
+        ~RadixSort() = default;
+
+        /**
+         * @brief Sort keys in ascending order
+         * @param keys  - float keys, any finite values
+         * @param count - number of keys
+         * @return Indices of keys in ascending order, valid until next sort
+         */
+        const std::vector<uint32_t>& sort(const float* keys, size_t count) noexcept;
+
+    private:
+        std::vector<uint32_t> keys_;
+        std::vector<uint32_t> swapKeys_;
+
+        std::vector<uint32_t> indices_;
+        std::vector<uint32_t> swapIndices_;
+
+    };
+
+}
@@ -0,0 +1,133 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace {
+    static thread_local bool insideLoop {false};
+}
+
+namespace glem {
+
+    ThreadPool::ThreadPool(size_t size)
+    {
+        const auto count = std::max<size_t>(size, 1u);
+
+        for(size_t i = 1; i < count; ++i)
+            workers_.emplace_back([this]() { work(); });
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock{mutex_};
+            stop_ = true;
+        }
+
+        wake_.notify_all();
+
+        for(auto& worker : workers_)
+            worker.join();
+    }
+
+    size_t ThreadPool::size() const noexcept
+    {
+        return workers_.size() + 1u;
+    }
+
+    void ThreadPool::parallelFor(size_t count, size_t chunk, const std::function<void(size_t, size_t)>& function) noexcept
+    {
+        if(count == 0u)
+            return;
+
+        chunk = std::max<size_t>(chunk, 1u);
+
+        /**** nested loop or nothing to share ****/
+        if(insideLoop || workers_.empty() || count <= chunk) {
+            for(size_t begin = 0; begin < count; begin += chunk)
+                function(begin, std::min(begin + chunk, count));
+
+            return;
+        }
+
+        std::lock_guard submit{submit_};
+
+        Job job;
+
+        job.function = &function;
+        job.count    = count;
+        job.chunk    = chunk;
+        job.total    = (count + chunk - 1u) / chunk;
+
+        {
+            std::lock_guard lock{mutex_};
+
+            job_ = &job;
+
+            ++generation_;
+        }
+
+        wake_.notify_all();
+
+        run(job);
+
+        std::unique_lock lock{mutex_};
+
+        /**** workers may still hold job, wait for them to leave it ****/
+        done_.wait(lock, [&]() { return job.finished.load() == job.total && active_ == 0u; });
+
+        job_ = nullptr;
+    }
+
+    void ThreadPool::work() noexcept
+    {
+        uint64_t generation {0u};
+
+        std::unique_lock lock{mutex_};
+
+        while(true) {
+            wake_.wait(lock, [&]() { return stop_ || generation != generation_; });
+
+            if(stop_)
+                return;
+
+            generation = generation_;
+
+            if(!job_)
+                continue;
+
+            auto job = job_;
+
+            ++active_;
+
+            lock.unlock();
+
+            run(*job);
+
+            lock.lock();
+
+            --active_;
+
+            done_.notify_all();
+        }
+    }
+
+    void ThreadPool::run(Job& job) noexcept
+    {
+        insideLoop = true;
+
+        size_t finished {0u};
+
+        for(auto index = job.next.fetch_add(1u); index < job.total; index = job.next.fetch_add(1u)) {
+            const auto begin = index * job.chunk;
+
+            (*job.function)(begin, std::min(begin + job.chunk, job.count));
+
+            ++finished;
+        }
+
+        job.finished.fetch_add(finished);
+
+        insideLoop = false;
+    }
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+namespace glem {
+
+    /**
+     * @brief Fixed set of worker threads running chunked parallel loops
+     *
+     * Calling thread takes part in every loop, so pool of size N owns N - 1
+     * workers. Loops issued from inside a running loop execute inline.
+     */
+    class ThreadPool {
+    public:
+        ThreadPool(size_t size = std::thread::hardware_concurrency());
+        ~ThreadPool();
+
+        ThreadPool(ThreadPool&&) = delete;
+        ThreadPool(const ThreadPool&) = delete;
+
+        ThreadPool& operator=(ThreadPool&&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Number of threads taking part in loop, including calling one
+         * @return
+         */
+        size_t size() const noexcept;
+
+        /**
+         * @brief Run function over [0, count) split into chunks, blocks until all chunks are done
+         * @param count    - number of elements
+         * @param chunk    - elements per chunk
+         * @param function - function(begin, end)
+         */
+        void parallelFor(size_t count, size_t chunk, const std::function<void(size_t, size_t)>& function) noexcept;
+
+    private:
+        struct Job {
+            const std::function<void(size_t, size_t)>* function {nullptr};
+
+            size_t count {0u};
+            size_t chunk {0u};
+            size_t total {0u};
+
+            std::atomic<size_t> next     {0u};
+            std::atomic<size_t> finished {0u};
+        };
+
+        void work() noexcept;
+
+        static void run(Job& job) noexcept;
+
+        std::vector<std::thread> workers_;
+
+        std::mutex              submit_;
+        std::mutex              mutex_;
+        std::condition_variable wake_;
+        std::condition_variable done_;
+
+        Job* job_ {nullptr};
+
+        size_t active_ {0u};
+
+        uint64_t generation_ {0u};
+
+        bool stop_ {false};
+
+    };
+
+}
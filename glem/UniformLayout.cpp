@@ -0,0 +1,152 @@
+#include "UniformLayout.hpp"
+
+#include "Log.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+    static constexpr const char* TAG = "UniformLayout";
+
+    static constexpr const size_t VECTOR4_ALIGNMENT = 16u;
+
+    inline size_t align(size_t value, size_t alignment) noexcept {
+        return (value + alignment - 1u) / alignment * alignment;
+    }
+}
+
+namespace glem {
+
+    namespace {
+        size_t sizeOf(MemberType type) noexcept {
+            switch (type) {
+            case MemberType::Int:
+                return MemberTypeMap<MemberType::Int>::size;
+            case MemberType::Float:
+                return MemberTypeMap<MemberType::Float>::size;
+            case MemberType::Vector2f:
+                return MemberTypeMap<MemberType::Vector2f>::size;
+            case MemberType::Vector3f:
+                return MemberTypeMap<MemberType::Vector3f>::size;
+            case MemberType::Vector4f:
+                return MemberTypeMap<MemberType::Vector4f>::size;
+            case MemberType::Matrix4f:
+                return MemberTypeMap<MemberType::Matrix4f>::size;
+            }
+
+            Log::e(TAG, "Unsupported member type.");
+
+            return 0u;
+        }
+
+        size_t alignmentOf(MemberType type) noexcept {
+            switch (type) {
+            case MemberType::Int:
+                return MemberTypeMap<MemberType::Int>::alignment;
+            case MemberType::Float:
+                return MemberTypeMap<MemberType::Float>::alignment;
+            case MemberType::Vector2f:
+                return MemberTypeMap<MemberType::Vector2f>::alignment;
+            case MemberType::Vector3f:
+                return MemberTypeMap<MemberType::Vector3f>::alignment;
+            case MemberType::Vector4f:
+                return MemberTypeMap<MemberType::Vector4f>::alignment;
+            case MemberType::Matrix4f:
+                return MemberTypeMap<MemberType::Matrix4f>::alignment;
+            }
+
+            Log::e(TAG, "Unsupported member type.");
+
+            return 1u;
+        }
+    }
+
+    Member::Member(MemberType type, const std::string &name, size_t offset, size_t count, size_t stride) :
+        type_{type}, name_{name}, offset_{offset}, count_{count}, stride_{stride}
+    {
+
+    }
+
+    MemberType Member::type() const noexcept
+    {
+        return type_;
+    }
+
+    std::string Member::name() const noexcept
+    {
+        return name_;
+    }
+
+    size_t Member::size() const noexcept
+    {
+        return sizeOf(type_);
+    }
+
+    size_t Member::offset() const noexcept
+    {
+        return offset_;
+    }
+
+    size_t Member::count() const noexcept
+    {
+        return count_;
+    }
+
+    size_t Member::stride() const noexcept
+    {
+        return stride_;
+    }
+
+    UniformLayout::UniformLayout(LayoutStandard standard) :
+        standard_{standard}
+    {
+
+    }
+
+    UniformLayout &UniformLayout::push(MemberType type, const std::string &name, size_t count) noexcept
+    {
+        const auto size = sizeOf(type);
+
+        auto alignment = alignmentOf(type);
+
+        /**** std140 rounds array element alignment and stride up to vec4, std430 doesn't ****/
+        if(count > 1u && standard_ == LayoutStandard::Std140)
+            alignment = std::max(alignment, VECTOR4_ALIGNMENT);
+
+        const auto stride = count > 1u ? align(size, alignment) : size;
+        const auto offset = align(size_, alignment);
+
+        layout_.emplace_back(type, name, offset, count, stride);
+
+        size_ = offset + (count > 1u ? stride * count : size);
+
+        return (*this);
+    }
+
+    const Member &UniformLayout::member(const std::string &value) const
+    {
+        for(const auto& m : layout_)
+            if(m.name() == value)
+                return m;
+
+        throw std::runtime_error("Couldn't find member.");
+
+        return layout_.front();
+    }
+
+    size_t UniformLayout::size() const noexcept
+    {
+        return align(size_, VECTOR4_ALIGNMENT);
+    }
+
+    LayoutStandard UniformLayout::standard() const noexcept
+    {
+        return standard_;
+    }
+
+    const std::vector<Member> &UniformLayout::members() const noexcept
+    {
+        return layout_;
+    }
+
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace glem {
+
+    /**
+     * @brief Interface block memory layout rules
+     */
+    enum class LayoutStandard {
+        Std140,
+        Std430
+    };
+
+    enum class MemberType {
+        Int,
+        Float,
+        Vector2f,
+        Vector3f,
+        Vector4f,
+        Matrix4f
+    };
+
+    template<MemberType> struct MemberTypeMap;
+
+    template<> struct MemberTypeMap<MemberType::Int> {
+        using value_type = int;
+
+        static constexpr const size_t size      = sizeof (int);
+        static constexpr const size_t alignment = 4u;
+    };
+
+    template<> struct MemberTypeMap<MemberType::Float> {
+        using value_type = float;
+
+        static constexpr const size_t size      = sizeof (float);
+        static constexpr const size_t alignment = 4u;
+    };
+
+    template<> struct MemberTypeMap<MemberType::Vector2f> {
+        using value_type = glm::vec2;
+
+        static constexpr const size_t size      = sizeof (glm::vec2);
+        static constexpr const size_t alignment = 8u;
+    };
+
+    template<> struct MemberTypeMap<MemberType::Vector3f> {
+        using value_type = glm::vec3;
+
+        static constexpr const size_t size      = sizeof (glm::vec3);
+        static constexpr const size_t alignment = 16u;
+    };
+
+    template<> struct MemberTypeMap<MemberType::Vector4f> {
+        using value_type = glm::vec4;
+
+        static constexpr const size_t size      = sizeof (glm::vec4);
+        static constexpr const size_t alignment = 16u;
+    };
+
+    template<> struct MemberTypeMap<MemberType::Matrix4f> {
+        using value_type = glm::mat4;
+
+        static constexpr const size_t size      = sizeof (glm::mat4);
+        static constexpr const size_t alignment = 16u;
+    };
+
+    class Member {
+    public:
+        Member(MemberType type, const std::string& name, size_t offset, size_t count, size_t stride);
+        ~Member() = default;
+
+        /**
+         * @brief Member type
+         * @return
+         */
+        MemberType type() const noexcept;
+
+        /**
+         * @brief Member name
+         * @return
+         */
+        std::string name() const noexcept;
+
+        /**
+         * @brief Size of single element in bytes
+         * @return
+         */
+        size_t size() const noexcept;
+
+        /**
+         * @brief Byte offset of first element in block
+         * @return
+         */
+        size_t offset() const noexcept;
+
+        /**
+         * @brief Array elements count, 1 for non array members
+         * @return
+         */
+        size_t count() const noexcept;
+
+        /**
+         * @brief Byte distance between array elements
+         * @return
+         */
+        size_t stride() const noexcept;
+
+    private:
+        MemberType type_;
+
+        std::string name_;
+
+        size_t offset_ {0u};
+        size_t count_  {1u};
+        size_t stride_ {0u};
+
+    };
+
+    /**
+     * @brief Interface block layout builder, members are placed by std140 or std430 rules in push order
+     */
+    class UniformLayout {
+    public:
+        UniformLayout(LayoutStandard standard = LayoutStandard::Std140);
+        ~UniformLayout() = default;
+
+        /**
+         * @brief Push member
+         * @param type  - Member type
+         * @param name  - Member name, as declared in block
+         * @param count - Array elements count
+         * @return
+         */
+        UniformLayout& push(MemberType type, const std::string& name, size_t count = 1u) noexcept;
+
+        /**
+         * @brief Member
+         * @param value - Member name
+         * @return
+         */
+        const Member& member(const std::string& value) const;
+
+        /**
+         * @brief Block size, rounded up to vec4
+         * @return
+         */
+        size_t size() const noexcept;
+
+        /**
+         * @brief Layout rules
+         * @return
+         */
+        LayoutStandard standard() const noexcept;
+
+        /**
+         * @brief Members
+         * @return
+         */
+        const std::vector<Member>& members() const noexcept;
+
+    private:
+        LayoutStandard standard_;
+
+        size_t size_ {0u};
+
+        std::vector<Member> layout_;
+
+    };
+
+}
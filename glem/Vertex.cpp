@@ -1,6 +1,7 @@
 #include "Vertex.hpp"
 
 #include "Log.hpp"
+#include "Hash.hpp"
 
 #include <algorithm>
 
@@ -33,6 +34,8 @@ namespace glem {
             return AttributeTypeMap<AttributeType::Vector2f>::size;
         case AttributeType::Vector3f:
             return AttributeTypeMap<AttributeType::Vector3f>::size;
+        case AttributeType::Vector4f:
+            return AttributeTypeMap<AttributeType::Vector4f>::size;
         }
 
         Log::e(TAG, "Unsupported attribute type.");
@@ -47,6 +50,8 @@ namespace glem {
             return AttributeTypeMap<AttributeType::Vector2f>::count;
         case AttributeType::Vector3f:
             return AttributeTypeMap<AttributeType::Vector3f>::count;
+        case AttributeType::Vector4f:
+            return AttributeTypeMap<AttributeType::Vector4f>::count;
         }
 
         Log::e(TAG, "Unsupported attribute type.");
@@ -99,6 +104,20 @@ namespace glem {
         return layout_;
     }
 
+    uint64_t VertexLayout::key() const noexcept
+    {
+        Hash hash;
+
+        hash.append(static_cast<uint32_t>(size_))
+            .append(static_cast<uint32_t>(layout_.size()));
+
+        for(const auto& attr : layout_)
+            hash.append(static_cast<uint32_t>(attr.type()))
+                .append(static_cast<uint32_t>(attr.offset()));
+
+        return hash.value();
+    }
+
     VertexByteBuffer::VertexByteBuffer(const VertexLayout &layout) :
         layout_{layout}
     {
@@ -15,7 +15,8 @@ namespace glem {
 
     enum class AttributeType {
         Vector2f,
-        Vector3f
+        Vector3f,
+        Vector4f
     };
 
     template<AttributeType> struct AttributeTypeMap;
@@ -36,6 +37,14 @@ namespace glem {
         static constexpr const size_t count      = 3;
     };
 
+    template<> struct AttributeTypeMap<AttributeType::Vector4f> {
+        using value_type = glm::vec4;
+
+        static constexpr const GLenum systemType = GL_FLOAT;
+        static constexpr const size_t size       = sizeof (GLfloat);
+        static constexpr const size_t count      = 4;
+    };
+
     class Attribute {
     public:
         Attribute(AttributeType type, const std::string& semantic, size_t offset);
@@ -125,6 +134,12 @@ namespace glem {
          */
         const std::vector<Attribute>& attributes() const noexcept;
 
+        /**
+         * @brief Format key, hash of attribute types and offsets, semantics are ignored
+         * @return
+         */
+        uint64_t key() const noexcept;
+
     private:
         size_t size_ {0u};
 
@@ -156,6 +171,9 @@ namespace glem {
             case AttributeType::Vector3f:
                 setAttribute<AttributeType::Vector3f>(ptr, std::forward<T>(value));
                 break;
+            case AttributeType::Vector4f:
+                setAttribute<AttributeType::Vector4f>(ptr, std::forward<T>(value));
+                break;
             }
         }
 